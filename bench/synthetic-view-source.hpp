@@ -0,0 +1,129 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <random>
+
+#include "view-source.hpp"
+
+struct synthetic_output_t
+{
+    int32_t id = -1;
+    std::string name;
+    info_rect_t geometry{};
+    /* Current workspace of the output's workspace set */
+    info_point_t workspace{};
+};
+
+/*
+ * Deterministic in-memory desktop: num_outputs 1920x1080 outputs side by
+ * side with 3x3 workspace grids, and num_views views spread over them with
+ * a mix of roles, app-ids and titles.
+ */
+class synthetic_view_source_t : public view_source_t
+{
+    std::vector<synthetic_output_t> outputs;
+    std::vector<view_info_t> views;
+    /* Storage of the strings views borrow */
+    std::vector<std::string> app_ids;
+    std::vector<std::string> titles;
+
+  public:
+    synthetic_view_source_t(size_t num_views, size_t num_outputs = 3, uint32_t seed = 1)
+    {
+        std::mt19937 rng(seed);
+        auto rand_int = [&] (int min, int max)
+        {
+            return std::uniform_int_distribution<int>(min, max)(rng);
+        };
+
+        for (size_t i = 0; i < num_outputs; i++)
+        {
+            synthetic_output_t output;
+            output.id   = i + 1;
+            output.name = "DP-" + std::to_string(i + 1);
+            output.geometry  = {int32_t(i) * 1920, 0, 1920, 1080};
+            output.workspace = {rand_int(0, 2), rand_int(0, 2)};
+            outputs.push_back(output);
+        }
+
+        static const std::string_view roles[] = {"toplevel", "toplevel", "toplevel",
+            "toplevel", "toplevel", "toplevel", "desktop-environment", "unmanaged"};
+
+        views.reserve(num_views);
+        app_ids.reserve(num_views);
+        titles.reserve(num_views);
+        for (size_t i = 0; i < num_views; i++)
+        {
+            view_info_t view;
+            /* Sparse ids, like a compositor which has been running for a while */
+            view.id  = 1000 + i * 7;
+            view.pid = rand_int(1000, 4000000);
+            app_ids.push_back("org.example.app" + std::to_string(i % 50));
+            titles.push_back("Window " + std::to_string(i) + " - \"document\" \\ " +
+                std::string(rand_int(0, 40), 'x'));
+            view.app_id = app_ids.back();
+            view.title  = titles.back();
+            view.role = roles[rand_int(0, 7)];
+            view.geometry  = {rand_int(-1920, 3840), rand_int(-1080, 2160), rand_int(100, 1920),
+                rand_int(100, 1080)};
+            view.bbox = view.base_geometry = view.geometry;
+            view.xwayland = rand_int(0, 9) == 0;
+            auto& output = outputs[i % outputs.size()];
+            view.output_name = output.name;
+            view.output_id   = output.id;
+            view.parent = (i > 0 && rand_int(0, 9) == 0) ? views[rand_int(0, i - 1)].id : -1;
+            view.last_focus_timestamp = i;
+            view.mapped     = true;
+            view.layer      = view.role == "toplevel" ? "workspace" : "top";
+            view.fullscreen = rand_int(0, 19) == 0;
+            view.minimized  = rand_int(0, 9) == 0;
+            view.wset_index = output.id;
+            view.min_size   = {100, 100};
+            view.focusable  = true;
+            view.type = view.role;
+            views.push_back(std::move(view));
+        }
+    }
+
+    const std::vector<view_info_t>& get_views() const
+    {
+        return views;
+    }
+
+    const std::vector<synthetic_output_t>& get_outputs() const
+    {
+        return outputs;
+    }
+
+    void for_each_view(const std::function<void(const view_info_t&)>& callback) override
+    {
+        for (auto& view : views)
+        {
+            callback(view);
+        }
+    }
+};
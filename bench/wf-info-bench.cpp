@@ -0,0 +1,167 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+ * Micro-benchmark of the wf-info info core on synthetic views. It does not
+ * need a compositor or a display.
+ *
+ * Usage: wf-info-bench [number of views...]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "info-core.hpp"
+#include "view-aggregate.hpp"
+#include "timeline-record.hpp"
+#include "synthetic-view-source.hpp"
+
+/* Keeps results alive so the compiler cannot drop the measured work */
+static volatile uint64_t sink;
+
+/* Run fn, which does ops operations, until at least 200ms have passed and
+ * print the time per operation */
+template<class F>
+static void run(const char *name, size_t num_views, size_t ops, F&& fn)
+{
+    using clock = std::chrono::steady_clock;
+
+    fn();
+    size_t iterations = 0;
+    auto start   = clock::now();
+    auto elapsed = clock::duration::zero();
+    do {
+        fn();
+        iterations++;
+        elapsed = clock::now() - start;
+    } while (elapsed < std::chrono::milliseconds(200));
+
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+    printf("%-24s %8zu views %12.1f ns/op\n", name, num_views, ns / (double(iterations) * ops));
+}
+
+static void bench(size_t num_views)
+{
+    synthetic_view_source_t source(num_views);
+    auto& views   = source.get_views();
+    auto& outputs = source.get_outputs();
+
+    run("workspace", num_views, num_views, [&] ()
+    {
+        uint64_t sum = 0;
+        for (auto& view : views)
+        {
+            auto& output = outputs[view.output_id - 1];
+            auto ws = compute_workspace(view.geometry,
+                {output.geometry.width, output.geometry.height}, output.workspace);
+            sum += ws.x + ws.y;
+        }
+
+        sink = sum;
+    });
+
+    view_filter_t filter;
+    filter.roles = {"toplevel", "desktop-environment"};
+    filter.require_output = true;
+    run("filter", num_views, num_views, [&] ()
+    {
+        uint64_t count = 0;
+        source.for_each_view([&] (const view_info_t& view)
+        {
+            count += filter.matches(view);
+        });
+        sink = count;
+    });
+
+    run("aggregate", num_views, num_views, [&] ()
+    {
+        auto aggregate = aggregate_views(source, filter, GROUP_ALL);
+        sink = aggregate.total.area + aggregate.by_workspace.size();
+    });
+
+    /* What wf-info -j does with each view_info event */
+    std::string buffer;
+    run("json", num_views, num_views, [&] ()
+    {
+        buffer.clear();
+        for (auto& view : views)
+        {
+            append_view_json<FIELD_WIRE>(buffer, view);
+            buffer += '\n';
+        }
+
+        sink = buffer.size();
+    });
+
+    run("wire-args", num_views, num_views, [&] ()
+    {
+        uint64_t sum = 0;
+        for (auto& view : views)
+        {
+            auto args = view_info_to_wire(view);
+            sum += std::get<0>(args) + (uintptr_t)std::get<4>(args);
+        }
+
+        sink = sum;
+    });
+
+    timeline_ring_t ring;
+    ring.resize(4096);
+    run("timeline-record", num_views, num_views, [&] ()
+    {
+        for (auto& view : views)
+        {
+            ring.record(TIMELINE_EVENT_GEOMETRY, view.id, view.geometry.x, view.geometry.y,
+                view.geometry.width, view.geometry.height);
+        }
+    });
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; i++)
+    {
+        sizes.push_back(strtoul(argv[i], nullptr, 10));
+    }
+
+    if (sizes.empty())
+    {
+        sizes = {10000, 100000};
+    }
+
+    for (auto size : sizes)
+    {
+        if (size > 0)
+        {
+            bench(size);
+        }
+    }
+
+    return 0;
+}
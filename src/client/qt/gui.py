@@ -1,10 +1,19 @@
 from PyQt5.QtWidgets import QApplication, QMainWindow, QLabel, QPushButton, QHBoxLayout, QVBoxLayout, QWidget
-from wf_info_base import WfInfoBase
+from wf_info_base import WfInfoBase, WfInfoBaseResource
 from pywayland.client import Display
+from PyQt5.QtGui import QImage, QPixmap
 from PyQt5.QtCore import Qt
+import inspect
+import mmap
+import os
 import signal
 import sys
 
+# The view_info event args, in protocol order
+VIEW_INFO_ARGS = list(inspect.signature(WfInfoBaseResource.view_info).parameters)[1:]
+
+THUMBNAIL_SIZE = 256
+
 class WfInfoApp(QMainWindow):
     def __init__(self, wf_info, clipboard):
         super().__init__()
@@ -40,10 +49,11 @@ class WfInfoApp(QMainWindow):
         self.layout.addWidget(self.info_button)
     def copy_text(self, text):
         self.clipboard.setText(text)
-    def handle_view_info(self, ok, view_id, client_pid, workspace_x, workspace_y, app_id, title, role, x, y, width, height, is_xwayland, focused, output, output_id):
+    def handle_view_info(self, ok, *args):
         self.reset()
-        labels = ["LABEL", "view_id", "client_pid", "workspace_x", "workspace_y", "app_id", "title", "role", "x", "y", "width", "height", "is_xwayland", "focused", "output", "output_id"]
-        values = ["VALUE", f"{view_id}", f"{client_pid}", f"{workspace_x}", f"{workspace_y}", f"{app_id}", f"{title}", f"{role}", f"{x}", f"{y}", f"{width}", f"{height}", f"{is_xwayland}", f"{focused}", f"{output}", f"{output_id}"]
+        self.view_id = args[VIEW_INFO_ARGS.index("view_id")]
+        labels = ["LABEL"] + VIEW_INFO_ARGS
+        values = ["VALUE"] + [f"{arg}" for arg in args]
         hlayout = QHBoxLayout()
         label_layout = QVBoxLayout()
         i = 0
@@ -78,10 +88,24 @@ class WfInfoApp(QMainWindow):
 
         self.layout.addLayout(hlayout)
         self.layout.addWidget(self.info_button)
+    def handle_thumbnail(self, ok, view_id, fd, width, height, stride, format):
+        # DRM_FORMAT_ARGB8888 is QImage.Format_ARGB32_Premultiplied on little endian
+        with mmap.mmap(fd, stride * height, mmap.MAP_PRIVATE, mmap.PROT_READ) as data:
+            image = QImage(bytes(data), width, height, stride, QImage.Format_ARGB32_Premultiplied).copy()
+        os.close(fd)
+        thumbnail_label = QLabel()
+        thumbnail_label.setPixmap(QPixmap.fromImage(image))
+        thumbnail_label.setAlignment(Qt.AlignCenter)
+        self.layout.insertWidget(self.layout.count() - 1, thumbnail_label)
     def get_info_text(self):
+        self.view_id = None
         self.wf_info["binding"].dispatcher["view_info"] = self.handle_view_info
         self.wf_info["binding"].view_info()
         self.wf_info["display"].dispatch(block=True)
+        if self.view_id is not None and self.wf_info["version"] >= 7:
+            self.wf_info["binding"].dispatcher["thumbnail"] = self.handle_thumbnail
+            self.wf_info["binding"].thumbnail(self.view_id, THUMBNAIL_SIZE, THUMBNAIL_SIZE)
+            self.wf_info["display"].roundtrip()
 
 
 def handle_registry_global(wl_registry, id_num, iface_name, version):
@@ -90,7 +114,8 @@ def handle_registry_global(wl_registry, id_num, iface_name, version):
     wf_info = wl_registry.user_data
     if iface_name == "wf_info_base":
         wf_info["enabled"] = True
-        wf_info["binding"] = wl_registry.bind(id_num, WfInfoBase, 1)
+        wf_info["version"] = min(version, WfInfoBase.version)
+        wf_info["binding"] = wl_registry.bind(id_num, WfInfoBase, wf_info["version"])
     return 1
 
 def wf_info_create():
@@ -41,7 +41,7 @@ class WfInfoBase(Interface):
     """
 
     name = "wf_info_base"
-    version = 1
+    version = 7
 
 
 class WfInfoBaseProxy(Proxy[WfInfoBase]):
@@ -78,6 +78,165 @@ class WfInfoBaseProxy(Proxy[WfInfoBase]):
         """
         self._marshal(2)
 
+    @WfInfoBase.request(
+        Argument(ArgumentType.Int),
+        version=2,
+    )
+    def frame_stats(self, output_id: int) -> None:
+        """Get frame timing statistics of outputs
+
+        Get frame timing statistics of the output with the given id, or of all
+        outputs if output_id is -1. One frame_stats event is sent per output,
+        followed by done.
+
+        :param output_id:
+            output ID, -1 for all outputs
+        :type output_id:
+            `ArgumentType.Int`
+        """
+        self._marshal(3, output_id)
+
+    @WfInfoBase.request(
+        Argument(ArgumentType.Int),
+        version=2,
+    )
+    def reset_frame_stats(self, output_id: int) -> None:
+        """Reset frame timing statistics of outputs
+
+        Reset frame timing statistics of the output with the given id, or of
+        all outputs if output_id is -1. done is sent when finished.
+
+        :param output_id:
+            output ID, -1 for all outputs
+        :type output_id:
+            `ArgumentType.Int`
+        """
+        self._marshal(4, output_id)
+
+    @WfInfoBase.request(version=3)
+    def timeline(self) -> None:
+        """Get the recorded event timeline
+
+        Get the events recorded by the timeline recorder. A timeline event is
+        sent, followed by done. If the recorder is disabled, the timeline is
+        empty.
+        """
+        self._marshal(5)
+
+    @WfInfoBase.request(version=4)
+    def layout_snapshot(self) -> None:
+        """Get a snapshot of the desktop layout
+
+        Get outputs, workspace sets and views in a single consistent pass. An
+        output_info event is sent for each output, a wset_info event for each
+        workspace set, and a view_info event followed by a view_layout event
+        for each toplevel and desktop environment view on an output, followed
+        by done.
+        """
+        self._marshal(6)
+
+    @WfInfoBase.request(
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        version=5,
+    )
+    def mru_views(self, count: int, output_id: int) -> None:
+        """Get views in most recently focused order
+
+        Get up to count toplevel views, most recently focused first, or all of
+        them if count is -1. Only views on the output with the given id are
+        sent unless output_id is -1. A view_info event is sent for each view,
+        followed by done.
+
+        :param count:
+            maximum number of views, -1 for all
+        :type count:
+            `ArgumentType.Int`
+        :param output_id:
+            output ID, -1 for all outputs
+        :type output_id:
+            `ArgumentType.Int`
+        """
+        self._marshal(7, count, output_id)
+
+    @WfInfoBase.request(
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        version=5,
+    )
+    def stacking_order(self, count: int, output_id: int) -> None:
+        """Get views in stacking order
+
+        Get up to count views of the workspace set of the output with the
+        given id, topmost first, or all of them if count is -1. If output_id
+        is -1, the focused output is used. A view_info event is sent for each
+        view, followed by done.
+
+        :param count:
+            maximum number of views, -1 for all
+        :type count:
+            `ArgumentType.Int`
+        :param output_id:
+            output ID, -1 for the focused output
+        :type output_id:
+            `ArgumentType.Int`
+        """
+        self._marshal(8, count, output_id)
+
+    @WfInfoBase.request(
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Int),
+        version=6,
+    )
+    def aggregate(self, group_by: int, output_id: int) -> None:
+        """Get view counts grouped by app-id, pid, output and workspace
+
+        Count toplevel views in a single pass, restricted to the output with
+        the given id unless output_id is -1. group_by is a bitmask of 1 for
+        app-id, 2 for pid, 4 for output and 8 for workspace. A view_group
+        event is sent with the totals and one for each group, followed by
+        done.
+
+        :param group_by:
+            bitmask of groupings to compute
+        :type group_by:
+            `ArgumentType.Uint`
+        :param output_id:
+            output ID, -1 for all outputs
+        :type output_id:
+            `ArgumentType.Int`
+        """
+        self._marshal(9, group_by, output_id)
+
+    @WfInfoBase.request(
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        version=7,
+    )
+    def thumbnail(self, view_id: int, max_width: int, max_height: int) -> None:
+        """Get a downscaled image of a view
+
+        Get the contents of the view with the given id, downscaled to fit into
+        max_width x max_height with the aspect ratio kept. Sizes are clamped
+        to the range 16 to 1024. A thumbnail event is sent, followed by done.
+        If the view does not exist or cannot be rendered, only done is sent.
+
+        :param view_id:
+            view ID
+        :type view_id:
+            `ArgumentType.Uint`
+        :param max_width:
+            maximum width of the thumbnail
+        :type max_width:
+            `ArgumentType.Int`
+        :param max_height:
+            maximum height of the thumbnail
+        :type max_height:
+            `ArgumentType.Int`
+        """
+        self._marshal(10, view_id, max_width, max_height)
+
 
 class WfInfoBaseResource(Resource):
     interface = WfInfoBase
@@ -175,6 +334,363 @@ class WfInfoBaseResource(Resource):
         """
         self._post_event(1)
 
+    @WfInfoBase.event(
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.String),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        version=2,
+    )
+    def frame_stats(self, output_id: int, output: str, frames: int, presented: int, dropped: int, missed: int, frame_time_avg: int, frame_time_p50: int, frame_time_p99: int, frame_time_max: int, render_time_avg: int, render_time_p99: int, render_time_max: int) -> None:
+        """Export frame timing statistics of an output to a client
+
+        Provide client with frame timing statistics of an output over the last
+        10 seconds, or since the statistics were last reset if that was more
+        recent. All times are in microseconds.
+
+        :param output_id:
+            ID of the output
+        :type output_id:
+            `ArgumentType.Uint`
+        :param output:
+            Name of the output
+        :type output:
+            `ArgumentType.String`
+        :param frames:
+            number of rendered frames
+        :type frames:
+            `ArgumentType.Uint`
+        :param presented:
+            number of presented frames
+        :type presented:
+            `ArgumentType.Uint`
+        :param dropped:
+            number of frames that were not presented
+        :type dropped:
+            `ArgumentType.Uint`
+        :param missed:
+            number of vblanks missed while rendering continuously
+        :type missed:
+            `ArgumentType.Uint`
+        :param frame_time_avg:
+            average time between presented frames
+        :type frame_time_avg:
+            `ArgumentType.Uint`
+        :param frame_time_p50:
+            median time between presented frames
+        :type frame_time_p50:
+            `ArgumentType.Uint`
+        :param frame_time_p99:
+            99th percentile time between presented frames
+        :type frame_time_p99:
+            `ArgumentType.Uint`
+        :param frame_time_max:
+            maximum time between presented frames
+        :type frame_time_max:
+            `ArgumentType.Uint`
+        :param render_time_avg:
+            average time from vblank to render done
+        :type render_time_avg:
+            `ArgumentType.Uint`
+        :param render_time_p99:
+            99th percentile time from vblank to render done
+        :type render_time_p99:
+            `ArgumentType.Uint`
+        :param render_time_max:
+            maximum time from vblank to render done
+        :type render_time_max:
+            `ArgumentType.Uint`
+        """
+        self._post_event(2, output_id, output, frames, presented, dropped, missed, frame_time_avg, frame_time_p50, frame_time_p99, frame_time_max, render_time_avg, render_time_p99, render_time_max)
+
+    @WfInfoBase.event(
+        Argument(ArgumentType.FileDescriptor),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        version=3,
+    )
+    def timeline(self, fd: int, record_size: int, count: int) -> None:
+        """Export the recorded event timeline to a client
+
+        Provide client with a sealed memfd containing count fixed size binary
+        records, oldest first. The record layout is described in
+        src/common/timeline-record.hpp.
+
+        :param fd:
+            memfd containing the records
+        :type fd:
+            `ArgumentType.FileDescriptor`
+        :param record_size:
+            size of a single record in bytes
+        :type record_size:
+            `ArgumentType.Uint`
+        :param count:
+            number of records
+        :type count:
+            `ArgumentType.Uint`
+        """
+        self._post_event(3, fd, record_size, count)
+
+    @WfInfoBase.event(
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.String),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Uint),
+        version=4,
+    )
+    def output_info(self, output_id: int, output: str, x: int, y: int, width: int, height: int, workarea_x: int, workarea_y: int, workarea_width: int, workarea_height: int, wset_index: int) -> None:
+        """Export information about an output to a client
+
+        Provide client with the layout of an output.
+
+        :param output_id:
+            ID of the output
+        :type output_id:
+            `ArgumentType.Uint`
+        :param output:
+            Name of the output
+        :type output:
+            `ArgumentType.String`
+        :param x:
+            output x position in the layout
+        :type x:
+            `ArgumentType.Int`
+        :param y:
+            output y position in the layout
+        :type y:
+            `ArgumentType.Int`
+        :param width:
+            output width
+        :type width:
+            `ArgumentType.Int`
+        :param height:
+            output height
+        :type height:
+            `ArgumentType.Int`
+        :param workarea_x:
+            workarea x position
+        :type workarea_x:
+            `ArgumentType.Int`
+        :param workarea_y:
+            workarea y position
+        :type workarea_y:
+            `ArgumentType.Int`
+        :param workarea_width:
+            workarea width
+        :type workarea_width:
+            `ArgumentType.Int`
+        :param workarea_height:
+            workarea height
+        :type workarea_height:
+            `ArgumentType.Int`
+        :param wset_index:
+            index of the output's workspace set
+        :type wset_index:
+            `ArgumentType.Uint`
+        """
+        self._post_event(4, output_id, output, x, y, width, height, workarea_x, workarea_y, workarea_width, workarea_height, wset_index)
+
+    @WfInfoBase.event(
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.String),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        version=4,
+    )
+    def wset_info(self, wset_index: int, name: str, output_id: int, workspace_x: int, workspace_y: int, grid_width: int, grid_height: int) -> None:
+        """Export information about a workspace set to a client
+
+        Provide client with the workspace grid of a workspace set.
+
+        :param wset_index:
+            index of the workspace set
+        :type wset_index:
+            `ArgumentType.Uint`
+        :param name:
+            name of the workspace set
+        :type name:
+            `ArgumentType.String`
+        :param output_id:
+            ID of the attached output, -1 if none
+        :type output_id:
+            `ArgumentType.Int`
+        :param workspace_x:
+            current workspace x
+        :type workspace_x:
+            `ArgumentType.Int`
+        :param workspace_y:
+            current workspace y
+        :type workspace_y:
+            `ArgumentType.Int`
+        :param grid_width:
+            workspace grid width
+        :type grid_width:
+            `ArgumentType.Int`
+        :param grid_height:
+            workspace grid height
+        :type grid_height:
+            `ArgumentType.Int`
+        """
+        self._post_event(5, wset_index, name, output_id, workspace_x, workspace_y, grid_width, grid_height)
+
+    @WfInfoBase.event(
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        version=4,
+    )
+    def view_layout(self, view_id: int, parent_id: int, wset_index: int) -> None:
+        """Export layout relations of a view to a client
+
+        Sent after view_info during a layout snapshot.
+
+        :param view_id:
+            view wayfire ID
+        :type view_id:
+            `ArgumentType.Uint`
+        :param parent_id:
+            ID of the parent view, -1 if none
+        :type parent_id:
+            `ArgumentType.Int`
+        :param wset_index:
+            index of the view's workspace set, -1 if none
+        :type wset_index:
+            `ArgumentType.Int`
+        """
+        self._post_event(6, view_id, parent_id, wset_index)
+
+    @WfInfoBase.event(
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.String),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Int),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        version=6,
+    )
+    def view_group(self, group: int, app_id: str, pid: int, output_id: int, workspace_x: int, workspace_y: int, count: int, minimized: int, fullscreen: int, area_hi: int, area_lo: int) -> None:
+        """Export view counts of a group to a client
+
+        Provide client with the counts of one group of an aggregate request.
+        group is 0 for the totals, otherwise the group_by bit of the grouping.
+        Members which are not part of the grouping are empty or -1. area is
+        the summed geometry area of views which are not minimized, split into
+        the high and low 32 bits.
+
+        :param group:
+            grouping of this group, 0 for totals
+        :type group:
+            `ArgumentType.Uint`
+        :param app_id:
+            application ID
+        :type app_id:
+            `ArgumentType.String`
+        :param pid:
+            client PID
+        :type pid:
+            `ArgumentType.Int`
+        :param output_id:
+            output ID
+        :type output_id:
+            `ArgumentType.Int`
+        :param workspace_x:
+            workspace x
+        :type workspace_x:
+            `ArgumentType.Int`
+        :param workspace_y:
+            workspace y
+        :type workspace_y:
+            `ArgumentType.Int`
+        :param count:
+            number of views
+        :type count:
+            `ArgumentType.Uint`
+        :param minimized:
+            number of minimized views
+        :type minimized:
+            `ArgumentType.Uint`
+        :param fullscreen:
+            number of fullscreen views
+        :type fullscreen:
+            `ArgumentType.Uint`
+        :param area_hi:
+            high 32 bits of the covered area
+        :type area_hi:
+            `ArgumentType.Uint`
+        :param area_lo:
+            low 32 bits of the covered area
+        :type area_lo:
+            `ArgumentType.Uint`
+        """
+        self._post_event(7, group, app_id, pid, output_id, workspace_x, workspace_y, count, minimized, fullscreen, area_hi, area_lo)
+
+    @WfInfoBase.event(
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.FileDescriptor),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        Argument(ArgumentType.Uint),
+        version=7,
+    )
+    def thumbnail(self, view_id: int, fd: int, width: int, height: int, stride: int, format: int) -> None:
+        """Export a downscaled image of a view to a client
+
+        Provide client with a thumbnail of a view in a sealed shared memory
+        file of stride * height bytes. The pixels have premultiplied alpha and
+        are in the given DRM format. The client must close fd.
+
+        :param view_id:
+            view wayfire ID
+        :type view_id:
+            `ArgumentType.Uint`
+        :param fd:
+            shared memory file with the pixels
+        :type fd:
+            `ArgumentType.FileDescriptor`
+        :param width:
+            thumbnail width
+        :type width:
+            `ArgumentType.Uint`
+        :param height:
+            thumbnail height
+        :type height:
+            `ArgumentType.Uint`
+        :param stride:
+            bytes per row
+        :type stride:
+            `ArgumentType.Uint`
+        :param format:
+            DRM fourcc of the pixel format
+        :type format:
+            `ArgumentType.Uint`
+        """
+        self._post_event(8, view_id, fd, width, height, stride, format)
+
 
 class WfInfoBaseGlobal(Global):
     interface = WfInfoBase
@@ -27,8 +27,14 @@
 #include <string.h>
 #include <getopt.h>
 #include <vector>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/mman.h>
 
 #include "wf-info.hpp"
+#include "timeline-record.hpp"
+#include "info-core.hpp"
+#include "view-aggregate.hpp"
 
 static void registry_add(void *data, struct wl_registry *registry,
     uint32_t id, const char *interface,
@@ -40,7 +46,7 @@ static void registry_add(void *data, struct wl_registry *registry,
     {
         wfm->wf_information_manager = (wf_info_base *)
             wl_registry_bind(registry, id,
-            &wf_info_base_interface, 1);
+            &wf_info_base_interface, std::min(version, 7u));
     }
 }
 
@@ -55,38 +61,265 @@ static const struct wl_registry_listener registry_listener = {
     .global_remove = registry_remove,
 };
 
-static void receive_view_info(void *data,
+static void print_field_value(std::string_view value)
+{
+    std::cout << value;
+}
+
+static void print_field_value(int32_t value)
+{
+    std::cout << value;
+}
+
+static void print_field_value(uint32_t value)
+{
+    std::cout << value;
+}
+
+static void print_field_value(bool value)
+{
+    std::cout << (value ? "true" : "false");
+}
+
+static void print_field_value(const info_rect_t& r)
+{
+    std::cout << r.x << "," << r.y << " " << r.width << "x" << r.height;
+}
+
+static void print_field_value(const std::optional<info_point_t>& p)
+{
+    if (p)
+    {
+        std::cout << p->x << "," << p->y;
+    }
+}
+
+static void print_view_info(const view_info_t& info)
+{
+    std::cout << "=========================" << std::endl;
+    for_each_view_field<FIELD_CLI>(info, [&] (auto& field, auto& value)
+    {
+        std::cout << field.label << ": ";
+        print_field_value(value);
+        std::cout << std::endl;
+        if (field.key == "pid")
+        {
+            std::cout << "Output: " << info.output_name << "(ID: " << uint32_t(info.output_id) << ")" <<
+                std::endl;
+        }
+    });
+    std::cout << "=========================" << std::endl;
+}
+
+/* Listener with the args of the view_info event as described by view_fields */
+template<class Args>
+struct view_info_listener;
+
+template<class... Args>
+struct view_info_listener<std::tuple<Args...>>
+{
+    static void receive(void *data, struct wf_info_base *wf_info_base, Args... args)
+    {
+        WfInfo *wfm = (WfInfo*)data;
+        auto info   = view_info_from_wire(args...);
+        if (!wfm->json_output)
+        {
+            print_view_info(info);
+            return;
+        }
+
+        /* Only the wire fields are known to the client */
+        wfm->json_buffer.clear();
+        append_view_json<FIELD_WIRE>(wfm->json_buffer, info);
+        wfm->json_buffer += '\n';
+        std::cout << wfm->json_buffer;
+    }
+};
+
+static void receive_frame_stats(void *data,
     struct wf_info_base *wf_info_base,
-    const uint32_t view_id,
-    const int client_pid,
-    const int ws_x,
-    const int ws_y,
-    const char *app_id,
-    const char *title,
-    const char *role,
+    const uint32_t output_id,
+    const char *output_name,
+    const uint32_t frames,
+    const uint32_t presented,
+    const uint32_t dropped,
+    const uint32_t missed,
+    const uint32_t frame_time_avg,
+    const uint32_t frame_time_p50,
+    const uint32_t frame_time_p99,
+    const uint32_t frame_time_max,
+    const uint32_t render_time_avg,
+    const uint32_t render_time_p99,
+    const uint32_t render_time_max)
+{
+    std::cout << "=========================" << std::endl;
+    std::cout << "Output: " << output_name << "(ID: " << output_id << ")" << std::endl;
+    std::cout << "Frames: " << frames << " rendered, " << presented << " presented" << std::endl;
+    std::cout << "Dropped: " << dropped << std::endl;
+    std::cout << "Missed: " << missed << std::endl;
+    std::cout << "Frame time (us): avg " << frame_time_avg << ", p50 " << frame_time_p50 <<
+        ", p99 " << frame_time_p99 << ", max " << frame_time_max << std::endl;
+    std::cout << "Render time (us): avg " << render_time_avg << ", p99 " << render_time_p99 <<
+        ", max " << render_time_max << std::endl;
+    std::cout << "=========================" << std::endl;
+}
+
+static void receive_timeline(void *data,
+    struct wf_info_base *wf_info_base,
+    const int fd,
+    const uint32_t record_size,
+    const uint32_t count)
+{
+    if ((record_size != sizeof(timeline_record_t)) || !count)
+    {
+        if (count)
+        {
+            std::cerr << "Unsupported timeline record size " << record_size << std::endl;
+        }
+
+        close(fd);
+        return;
+    }
+
+    size_t size = size_t(record_size) * count;
+    void *map   = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        std::cerr << "Failed to map timeline" << std::endl;
+        return;
+    }
+
+    auto records = (const timeline_record_t*)map;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        auto& r = records[i];
+        std::cout << "{\"timestamp-ns\": " << r.timestamp_ns <<
+            ", \"event\": \"" << timeline_event_name(r.type) <<
+            "\", \"view-id\": " << r.view_id;
+        auto names = timeline_data_names(r.type);
+        for (int j = 0; j < 4; j++)
+        {
+            if (names[j])
+            {
+                std::cout << ", \"" << names[j] << "\": " << r.data[j];
+            }
+        }
+
+        std::cout << "}" << std::endl;
+    }
+
+    munmap(map, size);
+}
+
+static void receive_output_info(void *data,
+    struct wf_info_base *wf_info_base,
+    const uint32_t output_id,
+    const char *output_name,
     const int x,
     const int y,
     const int width,
     const int height,
-    const int xwayland,
-    const int focused,
-    const char * output_name,
-    const uint32_t output_id)
+    const int workarea_x,
+    const int workarea_y,
+    const int workarea_width,
+    const int workarea_height,
+    const uint32_t wset_index)
 {
     std::cout << "=========================" << std::endl;
-    std::cout << "View ID: " << view_id << std::endl;
-    std::cout << "Client PID: " << client_pid << std::endl;
     std::cout << "Output: " << output_name << "(ID: " << output_id << ")" << std::endl;
-    std::cout << "Workspace: " << ws_x << "," << ws_y << std::endl;
-    std::cout << "App ID: "  << app_id << std::endl;
-    std::cout << "Title: " << title << std::endl;
-    std::cout << "Role: " << role << std::endl;
     std::cout << "Geometry: " << x << "," << y << " " << width << "x" << height << std::endl;
-    std::cout << "Xwayland: " << (xwayland ? "true" : "false") << std::endl;
-    std::cout << "Focused: " << (focused ? "true" : "false") << std::endl;
+    std::cout << "Workarea: " << workarea_x << "," << workarea_y << " " <<
+        workarea_width << "x" << workarea_height << std::endl;
+    std::cout << "Workspace set: " << wset_index << std::endl;
     std::cout << "=========================" << std::endl;
 }
 
+static void receive_wset_info(void *data,
+    struct wf_info_base *wf_info_base,
+    const uint32_t wset_index,
+    const char *name,
+    const int output_id,
+    const int ws_x,
+    const int ws_y,
+    const int grid_width,
+    const int grid_height)
+{
+    std::cout << "=========================" << std::endl;
+    std::cout << "Workspace set: " << name << "(Index: " << wset_index << ")" << std::endl;
+    std::cout << "Output ID: " << output_id << std::endl;
+    std::cout << "Workspace: " << ws_x << "," << ws_y << std::endl;
+    std::cout << "Grid: " << grid_width << "x" << grid_height << std::endl;
+    std::cout << "=========================" << std::endl;
+}
+
+static void receive_view_layout(void *data,
+    struct wf_info_base *wf_info_base,
+    const uint32_t view_id,
+    const int parent_id,
+    const int wset_index)
+{
+    std::cout << "View ID: " << view_id << " Parent ID: " << parent_id <<
+        " Workspace set: " << wset_index << std::endl;
+}
+
+static void receive_view_group(void *data,
+    struct wf_info_base *wf_info_base,
+    const uint32_t group,
+    const char *app_id,
+    const int pid,
+    const int output_id,
+    const int ws_x,
+    const int ws_y,
+    const uint32_t count,
+    const uint32_t minimized,
+    const uint32_t fullscreen,
+    const uint32_t area_hi,
+    const uint32_t area_lo)
+{
+    switch (group)
+    {
+        case 0:
+            std::cout << "Total";
+            break;
+
+        case GROUP_APP_ID:
+            std::cout << "App ID " << app_id;
+            break;
+
+        case GROUP_PID:
+            std::cout << "PID " << pid;
+            break;
+
+        case GROUP_OUTPUT:
+            std::cout << "Output ID " << output_id;
+            break;
+
+        case GROUP_WORKSPACE:
+            std::cout << "Output ID " << output_id << " workspace " << ws_x << "," << ws_y;
+            break;
+
+        default:
+            return;
+    }
+
+    std::cout << ": " << count << " views, " << minimized << " minimized, " <<
+        fullscreen << " fullscreen, area " << ((uint64_t(area_hi) << 32) | area_lo) << std::endl;
+}
+
+static void receive_thumbnail(void *data,
+    struct wf_info_base *wf_info_base,
+    const uint32_t view_id,
+    const int fd,
+    const uint32_t width,
+    const uint32_t height,
+    const uint32_t stride,
+    const uint32_t format)
+{
+    /* Thumbnails are for graphical clients */
+    close(fd);
+}
+
 static void done(void *data,
     struct wf_info_base *wf_info_base)
 {
@@ -94,8 +327,15 @@ static void done(void *data,
 }
 
 static struct wf_info_base_listener information_base_listener {
-	.view_info = receive_view_info,
+	.view_info = view_info_listener<view_info_wire_t>::receive,
 	.done = done,
+	.frame_stats = receive_frame_stats,
+	.timeline = receive_timeline,
+	.output_info = receive_output_info,
+	.wset_info = receive_wset_info,
+	.view_layout = receive_view_layout,
+	.view_group = receive_view_group,
+	.thumbnail = receive_thumbnail,
 };
 
 WfInfo::WfInfo(int argc, char *argv[])
@@ -129,12 +369,22 @@ WfInfo::WfInfo(int argc, char *argv[])
     struct option opts[] = {
         { "view-id",     required_argument, NULL, 'i' },
         { "all-views",   no_argument,       NULL, 'l' },
+        { "frame-stats", no_argument,       NULL, 'f' },
+        { "reset-frame-stats", no_argument, NULL, 'r' },
+        { "timeline",    no_argument,       NULL, 't' },
+        { "snapshot",    no_argument,       NULL, 's' },
+        { "mru",         no_argument,       NULL, 'm' },
+        { "stacking",    no_argument,       NULL, 'z' },
+        { "count",       required_argument, NULL, 'c' },
+        { "aggregate",   no_argument,       NULL, 'a' },
+        { "json",        no_argument,       NULL, 'j' },
         { 0,             0,                 NULL,  0  }
     };
 
     std::vector<int> view_ids;
-    int c, i, list_all_views = 0;
-    while((c = getopt_long(argc, argv, "i:l", opts, &i)) != -1)
+    int c, i, list_all_views = 0, frame_stats = 0, reset_frame_stats = 0, timeline = 0, snapshot = 0;
+    int mru = 0, stacking = 0, count = -1, aggregate = 0;
+    while((c = getopt_long(argc, argv, "i:lfrtsmzc:aj", opts, &i)) != -1)
     {
         switch(c)
         {
@@ -146,6 +396,42 @@ WfInfo::WfInfo(int argc, char *argv[])
                 list_all_views = 1;
                 break;
 
+            case 'f':
+                frame_stats = 1;
+                break;
+
+            case 'r':
+                reset_frame_stats = 1;
+                break;
+
+            case 't':
+                timeline = 1;
+                break;
+
+            case 's':
+                snapshot = 1;
+                break;
+
+            case 'm':
+                mru = 1;
+                break;
+
+            case 'z':
+                stacking = 1;
+                break;
+
+            case 'c':
+                count = atoi(optarg);
+                break;
+
+            case 'a':
+                aggregate = 1;
+                break;
+
+            case 'j':
+                json_output = true;
+                break;
+
             default:
                 printf("Unsupported command line argument %s\n", optarg);
         }
@@ -156,7 +442,72 @@ WfInfo::WfInfo(int argc, char *argv[])
         wf_info_base_view_info_id(wf_information_manager, view_id);
     }
 
-    if (list_all_views)
+    if (frame_stats && reset_frame_stats)
+    {
+        std::cout << "-f and -r cannot be used together." << std::endl;
+        return;
+    }
+
+    if ((frame_stats || reset_frame_stats) &&
+        wf_info_base_get_version(wf_information_manager) < 2)
+    {
+        std::cout << "Frame statistics are not supported by this version of the wf-info plugin." << std::endl;
+        return;
+    }
+
+    if (timeline && wf_info_base_get_version(wf_information_manager) < 3)
+    {
+        std::cout << "Event timeline is not supported by this version of the wf-info plugin." << std::endl;
+        return;
+    }
+
+    if (snapshot && wf_info_base_get_version(wf_information_manager) < 4)
+    {
+        std::cout << "Layout snapshots are not supported by this version of the wf-info plugin." << std::endl;
+        return;
+    }
+
+    if ((mru || stacking) && wf_info_base_get_version(wf_information_manager) < 5)
+    {
+        std::cout << "View ordering is not supported by this version of the wf-info plugin." << std::endl;
+        return;
+    }
+
+    if (aggregate && wf_info_base_get_version(wf_information_manager) < 6)
+    {
+        std::cout << "View aggregation is not supported by this version of the wf-info plugin." << std::endl;
+        return;
+    }
+
+    if (aggregate)
+    {
+        wf_info_base_aggregate(wf_information_manager, GROUP_ALL, -1);
+    }
+    else if (mru)
+    {
+        wf_info_base_mru_views(wf_information_manager, count, -1);
+    }
+    else if (stacking)
+    {
+        wf_info_base_stacking_order(wf_information_manager, count, -1);
+    }
+    else if (snapshot)
+    {
+        wf_info_base_layout_snapshot(wf_information_manager);
+    }
+    else if (timeline)
+    {
+        wf_info_base_timeline(wf_information_manager);
+    }
+    else if (frame_stats)
+    {
+        wf_info_base_frame_stats(wf_information_manager, -1);
+    }
+    else if (reset_frame_stats)
+    {
+        wf_info_base_reset_frame_stats(wf_information_manager, -1);
+    }
+    else if (list_all_views)
     {
         wf_info_base_view_info_list(wf_information_manager);
     }
@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <string>
+
 #include "wayfire-information-client-protocol.h"
 
 class WfInfo
@@ -35,4 +37,7 @@ class WfInfo
 
     wl_display *display;
     wf_info_base *wf_information_manager;
+    /* Print view info as JSON lines, reusing json_buffer */
+    bool json_output = false;
+    std::string json_buffer;
 };
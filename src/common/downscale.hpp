@@ -0,0 +1,159 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "view-fields.hpp"
+
+/*
+ * Box filter downscaling of 32 bits per pixel images for thumbnails. Every
+ * destination pixel is the average of the source pixels it covers, which is
+ * correct for premultiplied alpha. Channels are averaged independently, so
+ * the byte order of the format does not matter.
+ */
+
+/* Largest size with the aspect ratio of src which fits into max, never upscaled */
+static inline info_size_t fit_size(info_size_t src, info_size_t max)
+{
+    if ((src.width <= 0) || (src.height <= 0) || (max.width <= 0) || (max.height <= 0))
+    {
+        return {0, 0};
+    }
+
+    if ((src.width <= max.width) && (src.height <= max.height))
+    {
+        return src;
+    }
+
+    if (int64_t(src.width) * max.height > int64_t(src.height) * max.width)
+    {
+        return {max.width, std::max(1, int32_t(int64_t(src.height) * max.width / src.width))};
+    }
+
+    return {std::max(1, int32_t(int64_t(src.width) * max.height / src.height)), max.height};
+}
+
+namespace downscale_detail
+{
+/* acc[x * 4 + c] += row[x * 4 + c] */
+static inline void accumulate_row(uint32_t *acc, const uint8_t *row, int width)
+{
+    int x = 0;
+#ifdef __SSE2__
+    const __m128i zero = _mm_setzero_si128();
+    for (; x + 4 <= width; x += 4)
+    {
+        __m128i pixels = _mm_loadu_si128((const __m128i*)(row + x * 4));
+        __m128i lo     = _mm_unpacklo_epi8(pixels, zero);
+        __m128i hi     = _mm_unpackhi_epi8(pixels, zero);
+        __m128i *a     = (__m128i*)(acc + x * 4);
+        _mm_storeu_si128(a + 0, _mm_add_epi32(_mm_loadu_si128(a + 0), _mm_unpacklo_epi16(lo, zero)));
+        _mm_storeu_si128(a + 1, _mm_add_epi32(_mm_loadu_si128(a + 1), _mm_unpackhi_epi16(lo, zero)));
+        _mm_storeu_si128(a + 2, _mm_add_epi32(_mm_loadu_si128(a + 2), _mm_unpacklo_epi16(hi, zero)));
+        _mm_storeu_si128(a + 3, _mm_add_epi32(_mm_loadu_si128(a + 3), _mm_unpackhi_epi16(hi, zero)));
+    }
+
+#endif
+    for (int i = x * 4; i < width * 4; i++)
+    {
+        acc[i] += row[i];
+    }
+}
+
+/* Average the accumulated columns [x0, x1) into one pixel */
+static inline void reduce_box(const uint32_t *acc, int x0, int x1, float inv, uint8_t *out)
+{
+#ifdef __SSE2__
+    __m128i sum = _mm_setzero_si128();
+    for (int x = x0; x < x1; x++)
+    {
+        sum = _mm_add_epi32(sum, _mm_loadu_si128((const __m128i*)(acc + x * 4)));
+    }
+
+    __m128 avg = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(sum), _mm_set1_ps(inv)), _mm_set1_ps(0.5f));
+    __m128i v  = _mm_cvttps_epi32(avg);
+    v = _mm_packs_epi32(v, v);
+    v = _mm_packus_epi16(v, v);
+    uint32_t pixel = _mm_cvtsi128_si32(v);
+    memcpy(out, &pixel, 4);
+#else
+    for (int c = 0; c < 4; c++)
+    {
+        uint32_t sum = 0;
+        for (int x = x0; x < x1; x++)
+        {
+            sum += acc[x * 4 + c];
+        }
+
+        out[c] = uint8_t(std::min(255.0f, float(int32_t(sum)) * inv + 0.5f));
+    }
+#endif
+}
+}
+
+/*
+ * Downscale src to dst, both 4 bytes per pixel with strides in bytes. dst
+ * must not be larger than src in either dimension. The SSE2 and scalar paths
+ * give the same result.
+ */
+static inline void downscale_box(const uint8_t *src, int src_width, int src_height, int src_stride,
+    uint8_t *dst, int dst_width, int dst_height, int dst_stride)
+{
+    if ((dst_width <= 0) || (dst_height <= 0))
+    {
+        return;
+    }
+
+    std::vector<uint32_t> acc(size_t(src_width) * 4);
+    for (int dy = 0; dy < dst_height; dy++)
+    {
+        int y0 = int64_t(dy) * src_height / dst_height;
+        int y1 = std::max(y0 + 1, int(int64_t(dy + 1) * src_height / dst_height));
+
+        std::fill(acc.begin(), acc.end(), 0);
+        for (int y = y0; y < y1; y++)
+        {
+            downscale_detail::accumulate_row(acc.data(), src + size_t(y) * src_stride, src_width);
+        }
+
+        uint8_t *out = dst + size_t(dy) * dst_stride;
+        for (int dx = 0; dx < dst_width; dx++)
+        {
+            int x0 = int64_t(dx) * src_width / dst_width;
+            int x1 = std::max(x0 + 1, int(int64_t(dx + 1) * src_width / dst_width));
+            float inv = 1.0f / float((x1 - x0) * (y1 - y0));
+            downscale_detail::reduce_box(acc.data(), x0, x1, inv, out + dx * 4);
+        }
+    }
+}
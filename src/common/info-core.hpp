@@ -0,0 +1,224 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <charconv>
+
+#include "view-fields.hpp"
+
+/*
+ * Compositor-independent parts of wf-info which operate on view_info_t.
+ * The plugin, the client, the tests and the micro-benchmark share these.
+ */
+
+/* Workspace which contains the center of bbox, in output-local coordinates */
+static inline info_point_t compute_workspace(const info_rect_t& bbox,
+    info_size_t screen, info_point_t current)
+{
+    return {
+        current.x + (int32_t)std::floor((bbox.x + bbox.width / 2.0) / screen.width),
+        current.y + (int32_t)std::floor((bbox.y + bbox.height / 2.0) / screen.height)
+    };
+}
+
+struct view_filter_t
+{
+    /* Empty members match any view */
+    std::vector<std::string_view> roles;
+    std::string_view app_id;
+    int32_t output_id = -1;
+    bool require_output = false;
+
+    bool matches(const view_info_t& info) const
+    {
+        if (!roles.empty() && (std::find(roles.begin(), roles.end(), info.role) == roles.end()))
+        {
+            return false;
+        }
+
+        if (!app_id.empty() && (info.app_id != app_id))
+        {
+            return false;
+        }
+
+        if ((require_output || (output_id != -1)) && (info.output_id == -1))
+        {
+            return false;
+        }
+
+        return (output_id == -1) || (info.output_id == output_id);
+    }
+};
+
+/*
+ * Streaming JSON writer. Appending to a buffer which is reused between calls
+ * does not allocate once the buffer has grown to its working size.
+ */
+static inline void append_json_string(std::string& out, std::string_view value)
+{
+    static constexpr char hex[] = "0123456789abcdef";
+
+    out += '"';
+    size_t run = 0;
+    for (size_t i = 0; i < value.size(); i++)
+    {
+        unsigned char c = value[i];
+        if ((c >= 0x20) && (c != '"') && (c != '\\'))
+        {
+            continue;
+        }
+
+        /* Copy unescaped runs in one go */
+        out.append(value.data() + run, i - run);
+        run = i + 1;
+        switch (c)
+        {
+          case '"':
+            out += "\\\"";
+            break;
+
+          case '\\':
+            out += "\\\\";
+            break;
+
+          case '\n':
+            out += "\\n";
+            break;
+
+          case '\t':
+            out += "\\t";
+            break;
+
+          default:
+            out += "\\u00";
+            out += hex[c >> 4];
+            out += hex[c & 0xf];
+        }
+    }
+
+    out.append(value.data() + run, value.size() - run);
+    out += '"';
+}
+
+template<class T>
+static inline void append_json_number(std::string& out, T value)
+{
+    char buf[24];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, res.ptr - buf);
+}
+
+static inline void append_json_value(std::string& out, int32_t value)
+{
+    append_json_number(out, value);
+}
+
+static inline void append_json_value(std::string& out, uint32_t value)
+{
+    append_json_number(out, value);
+}
+
+static inline void append_json_value(std::string& out, int64_t value)
+{
+    append_json_number(out, value);
+}
+
+static inline void append_json_value(std::string& out, bool value)
+{
+    out += value ? "true" : "false";
+}
+
+static inline void append_json_value(std::string& out, const std::string& value)
+{
+    append_json_string(out, value);
+}
+
+static inline void append_json_value(std::string& out, std::string_view value)
+{
+    append_json_string(out, value);
+}
+
+static inline void append_json_value(std::string& out, const info_rect_t& r)
+{
+    out += "{\"x\":";
+    append_json_number(out, r.x);
+    out += ",\"y\":";
+    append_json_number(out, r.y);
+    out += ",\"width\":";
+    append_json_number(out, r.width);
+    out += ",\"height\":";
+    append_json_number(out, r.height);
+    out += '}';
+}
+
+static inline void append_json_value(std::string& out, const info_size_t& s)
+{
+    out += "{\"width\":";
+    append_json_number(out, s.width);
+    out += ",\"height\":";
+    append_json_number(out, s.height);
+    out += '}';
+}
+
+static inline void append_json_value(std::string& out, const std::optional<info_point_t>& p)
+{
+    if (!p)
+    {
+        out += "null";
+        return;
+    }
+
+    out += "{\"x\":";
+    append_json_number(out, p->x);
+    out += ",\"y\":";
+    append_json_number(out, p->y);
+    out += '}';
+}
+
+/* The same object as view_to_json() for the fields selected by Mask, used by
+ * wf-info -j */
+template<uint32_t Mask>
+static inline void append_view_json(std::string& out, const view_info_t& info)
+{
+    bool first = true;
+    out += '{';
+    for_each_view_field<Mask>(info, [&] (auto& field, auto& value)
+    {
+        if (!first)
+        {
+            out += ',';
+        }
+
+        first = false;
+        append_json_string(out, field.key);
+        out += ':';
+        append_json_value(out, value);
+    });
+    out += '}';
+}
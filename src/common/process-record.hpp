@@ -0,0 +1,121 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <string>
+#include <cstring>
+#include <stdint.h>
+#include <string_view>
+
+/*
+ * Process details read from /proc/<pid> by wf-info-proc-reader, and the
+ * messages it exchanges with the plugin over a SOCK_SEQPACKET socket. A
+ * request is a single int32_t pid, the reply is a process_record_header_t
+ * followed by the executable, cmdline and cgroup strings.
+ */
+struct process_record_t
+{
+    int32_t pid  = -1;
+    int32_t ppid = -1;
+    std::string executable;
+    std::string cmdline;
+    std::string cgroup;
+    uint64_t rss_kb = 0;
+    uint64_t cpu_time_ms = 0;
+    /* false if the process was already gone or could not be read */
+    bool valid = false;
+};
+
+struct process_record_header_t
+{
+    int32_t pid;
+    int32_t ppid;
+    uint64_t rss_kb;
+    uint64_t cpu_time_ms;
+    uint32_t valid;
+    uint32_t executable_len;
+    uint32_t cmdline_len;
+    uint32_t cgroup_len;
+};
+
+/* Longer strings are truncated to fit into a message of PROCESS_RECORD_MAX */
+static constexpr size_t PROCESS_RECORD_STRING_MAX = 4096;
+static constexpr size_t PROCESS_RECORD_MAX = sizeof(process_record_header_t) +
+    3 * PROCESS_RECORD_STRING_MAX;
+
+static inline void encode_process_record(std::string& out, const process_record_t& record)
+{
+    auto executable = std::string_view(record.executable).substr(0, PROCESS_RECORD_STRING_MAX);
+    auto cmdline    = std::string_view(record.cmdline).substr(0, PROCESS_RECORD_STRING_MAX);
+    auto cgroup     = std::string_view(record.cgroup).substr(0, PROCESS_RECORD_STRING_MAX);
+
+    process_record_header_t header{};
+    header.pid  = record.pid;
+    header.ppid = record.ppid;
+    header.rss_kb = record.rss_kb;
+    header.cpu_time_ms    = record.cpu_time_ms;
+    header.valid          = record.valid;
+    header.executable_len = executable.size();
+    header.cmdline_len    = cmdline.size();
+    header.cgroup_len     = cgroup.size();
+
+    out.assign((const char*)&header, sizeof(header));
+    out.append(executable);
+    out.append(cmdline);
+    out.append(cgroup);
+}
+
+/* false if data is not a complete record */
+static inline bool decode_process_record(std::string_view data, process_record_t& record)
+{
+    process_record_header_t header;
+    if (data.size() < sizeof(header))
+    {
+        return false;
+    }
+
+    memcpy(&header, data.data(), sizeof(header));
+    data.remove_prefix(sizeof(header));
+    if ((header.executable_len > PROCESS_RECORD_STRING_MAX) ||
+        (header.cmdline_len > PROCESS_RECORD_STRING_MAX) ||
+        (header.cgroup_len > PROCESS_RECORD_STRING_MAX) ||
+        (data.size() != size_t(header.executable_len) + header.cmdline_len + header.cgroup_len))
+    {
+        return false;
+    }
+
+    record.pid  = header.pid;
+    record.ppid = header.ppid;
+    record.rss_kb = header.rss_kb;
+    record.cpu_time_ms = header.cpu_time_ms;
+    record.valid = header.valid;
+    record.executable.assign(data.substr(0, header.executable_len));
+    data.remove_prefix(header.executable_len);
+    record.cmdline.assign(data.substr(0, header.cmdline_len));
+    data.remove_prefix(header.cmdline_len);
+    record.cgroup.assign(data);
+    return true;
+}
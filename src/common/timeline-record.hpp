@@ -0,0 +1,190 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+
+#include "timing.hpp"
+
+/*
+ * Binary format of the event timeline, shared by the plugin and the client.
+ * Records are fixed size and written in host byte order, the timeline is
+ * only meant to be decoded on the machine that recorded it.
+ */
+enum timeline_event_t : uint32_t
+{
+    TIMELINE_EVENT_MAP       = 1,
+    TIMELINE_EVENT_UNMAP     = 2,
+    TIMELINE_EVENT_FOCUS     = 3,
+    TIMELINE_EVENT_GEOMETRY  = 4,
+    TIMELINE_EVENT_TITLE     = 5,
+    TIMELINE_EVENT_OUTPUT    = 6,
+    TIMELINE_EVENT_WORKSPACE = 7,
+};
+
+struct timeline_record_t
+{
+    /* CLOCK_MONOTONIC */
+    uint64_t timestamp_ns;
+    uint32_t type;
+    /* 0 for events which are not about a view */
+    uint32_t view_id;
+    /* Meaning depends on type, see timeline_data_names() */
+    int32_t data[4];
+};
+
+static_assert(sizeof(timeline_record_t) == 32, "timeline records must stay 32 bytes");
+
+static inline const char *timeline_event_name(uint32_t type)
+{
+    switch (type)
+    {
+      case TIMELINE_EVENT_MAP:
+        return "map";
+
+      case TIMELINE_EVENT_UNMAP:
+        return "unmap";
+
+      case TIMELINE_EVENT_FOCUS:
+        return "focus";
+
+      case TIMELINE_EVENT_GEOMETRY:
+        return "geometry";
+
+      case TIMELINE_EVENT_TITLE:
+        return "title";
+
+      case TIMELINE_EVENT_OUTPUT:
+        return "output";
+
+      case TIMELINE_EVENT_WORKSPACE:
+        return "workspace";
+
+      default:
+        return "unknown";
+    }
+}
+
+/* Names of the used data fields of a record type, nullptr if unused. */
+static inline const char *const *timeline_data_names(uint32_t type)
+{
+    static const char *const geometry[4]  = {"x", "y", "width", "height"};
+    static const char *const title[4]     = {"length", nullptr, nullptr, nullptr};
+    static const char *const output[4]    = {"output-id", "old-output-id", nullptr, nullptr};
+    static const char *const workspace[4] = {"output-id", "x", "y", nullptr};
+    static const char *const none[4] = {nullptr, nullptr, nullptr, nullptr};
+
+    switch (type)
+    {
+      case TIMELINE_EVENT_MAP:
+      case TIMELINE_EVENT_GEOMETRY:
+        return geometry;
+
+      case TIMELINE_EVENT_TITLE:
+        return title;
+
+      case TIMELINE_EVENT_OUTPUT:
+        return output;
+
+      case TIMELINE_EVENT_WORKSPACE:
+        return workspace;
+
+      default:
+        return none;
+    }
+}
+
+/*
+ * Ring buffer of timeline records. There must be a single writer, which only
+ * pays for a timestamp, a 32 byte store and a release store of the head, so
+ * recording needs no locking. The capacity is a power of two.
+ */
+class timeline_ring_t
+{
+    std::vector<timeline_record_t> records;
+    std::atomic<uint64_t> head{0};
+    uint64_t mask = 0;
+
+  public:
+    /* Rounded up to a power of two, 0 frees the buffer */
+    void resize(size_t size)
+    {
+        records.clear();
+        records.shrink_to_fit();
+        head.store(0, std::memory_order_relaxed);
+        mask = 0;
+
+        if (!size)
+        {
+            return;
+        }
+
+        size_t capacity = 1;
+        while (capacity < size)
+        {
+            capacity <<= 1;
+        }
+
+        records.resize(capacity);
+        mask = capacity - 1;
+    }
+
+    size_t capacity() const
+    {
+        return records.size();
+    }
+
+    void record(uint32_t type, uint32_t view_id,
+        int32_t a = 0, int32_t b = 0, int32_t c = 0, int32_t d = 0)
+    {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        records[h & mask] = {get_monotonic_ns(), type, view_id, {a, b, c, d}};
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    /* Recorded events, oldest first */
+    std::vector<timeline_record_t> snapshot() const
+    {
+        std::vector<timeline_record_t> events;
+        uint64_t h = head.load(std::memory_order_acquire);
+        uint64_t n = std::min<uint64_t>(h, records.size());
+        events.reserve(n);
+        for (uint64_t i = h - n; i < h; i++)
+        {
+            events.push_back(records[i & mask]);
+        }
+
+        return events;
+    }
+
+    void clear()
+    {
+        head.store(0, std::memory_order_release);
+    }
+};
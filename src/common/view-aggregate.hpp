@@ -0,0 +1,138 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+#include "info-core.hpp"
+#include "view-source.hpp"
+
+/*
+ * Group-by summaries of views, computed in one pass so that clients which
+ * only want counts do not have to fetch every view.
+ */
+
+enum view_group_by : uint32_t
+{
+    GROUP_APP_ID    = 1 << 0,
+    GROUP_PID       = 1 << 1,
+    GROUP_OUTPUT    = 1 << 2,
+    GROUP_WORKSPACE = 1 << 3,
+    GROUP_ALL = GROUP_APP_ID | GROUP_PID | GROUP_OUTPUT | GROUP_WORKSPACE,
+};
+
+struct view_group_stats_t
+{
+    uint32_t count = 0;
+    uint32_t minimized  = 0;
+    uint32_t fullscreen = 0;
+    /* Sum of the geometry area of views which are not minimized, overlap is
+     * counted once per view */
+    uint64_t area = 0;
+
+    void add(const view_info_t& info)
+    {
+        count++;
+        minimized  += info.minimized;
+        fullscreen += info.fullscreen;
+        if (!info.minimized)
+        {
+            area += uint64_t(std::max(info.geometry.width, 0)) * uint64_t(std::max(info.geometry.height, 0));
+        }
+    }
+};
+
+struct workspace_key_t
+{
+    int32_t output_id;
+    int32_t x, y;
+
+    bool operator <(const workspace_key_t& other) const
+    {
+        return std::tie(output_id, x, y) < std::tie(other.output_id, other.x, other.y);
+    }
+};
+
+struct view_aggregate_t
+{
+    uint32_t groups = GROUP_ALL;
+    view_group_stats_t total;
+    std::unordered_map<std::string, view_group_stats_t> by_app_id;
+    std::unordered_map<int32_t, view_group_stats_t> by_pid;
+    std::map<int32_t, view_group_stats_t> by_output;
+    std::map<workspace_key_t, view_group_stats_t> by_workspace;
+
+    /* Lookup key, reused so that only new app-ids allocate */
+    std::string app_id_key;
+
+    /* Views without an output are only counted in the total, app-id and pid */
+    void add(const view_info_t& info)
+    {
+        total.add(info);
+        if (groups & GROUP_APP_ID)
+        {
+            app_id_key.assign(info.app_id);
+            by_app_id[app_id_key].add(info);
+        }
+
+        if (groups & GROUP_PID)
+        {
+            by_pid[info.pid].add(info);
+        }
+
+        if ((groups & GROUP_OUTPUT) && (info.output_id != -1))
+        {
+            by_output[info.output_id].add(info);
+        }
+
+        if ((groups & GROUP_WORKSPACE) && (info.output_id != -1) && info.workspace)
+        {
+            by_workspace[{info.output_id, info.workspace->x, info.workspace->y}].add(info);
+        }
+    }
+};
+
+/*
+ * The source only needs to fill in the FIELD_AGGREGATE fields. Unmapped views
+ * are skipped, like in every other view query.
+ */
+static inline view_aggregate_t aggregate_views(view_source_t& source,
+    const view_filter_t& filter, uint32_t groups)
+{
+    view_aggregate_t aggregate;
+    aggregate.groups = groups;
+    source.for_each_view([&] (const view_info_t& info)
+    {
+        if (info.mapped && filter.matches(info))
+        {
+            aggregate.add(info);
+        }
+    });
+
+    return aggregate;
+}
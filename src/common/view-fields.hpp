@@ -0,0 +1,418 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <tuple>
+#include <cassert>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <optional>
+#include <stdint.h>
+#include <string_view>
+
+/*
+ * Single description of the view properties exported by wf-info. The
+ * Wayland view_info event, the IPC JSON and the CLI printer are all generated
+ * from view_fields below, so adding a field here is the only change needed
+ * for it to appear everywhere its flags say it should.
+ *
+ * The order of FIELD_WIRE fields must match the args of the view_info event
+ * in wayfire-information.xml. The sender and the client listener are both
+ * instantiated from this table, so a field whose type does not match its arg
+ * fails to compile. Fields of the same type could still be swapped without
+ * that, so the order is also checked against view_info_wire_keys.
+ */
+
+struct info_point_t
+{
+    int32_t x, y;
+};
+
+struct info_size_t
+{
+    int32_t width, height;
+};
+
+struct info_rect_t
+{
+    int32_t x, y, width, height;
+};
+
+/*
+ * Strings are borrowed from the view or from storage of whoever filled in the
+ * info and are only valid as long as that. They are always NUL-terminated,
+ * so they can be sent as protocol strings directly.
+ */
+struct view_info_t
+{
+    uint32_t id = 0;
+    int32_t pid = -1;
+    std::optional<info_point_t> workspace;
+    std::string_view app_id = "";
+    std::string_view title = "";
+    /* Enum strings point to static constants */
+    std::string_view role = "";
+    info_rect_t geometry{};
+    bool xwayland = false;
+    bool focused  = false;
+    std::string_view output_name = "";
+    int32_t output_id = -1;
+    info_rect_t base_geometry{};
+    info_rect_t bbox{};
+    int32_t parent = -1;
+    int64_t last_focus_timestamp = 0;
+    bool mapped = false;
+    std::string_view layer = "";
+    uint32_t tiled_edges = 0;
+    bool fullscreen = false;
+    bool minimized  = false;
+    bool activated  = false;
+    bool sticky     = false;
+    int64_t wset_index = -1;
+    info_size_t min_size{};
+    info_size_t max_size{};
+    bool focusable = false;
+    std::string_view type = "";
+};
+
+enum view_field_flags : uint32_t
+{
+    /* Sent in the view_info Wayland event */
+    FIELD_WIRE = 1 << 0,
+    /* Part of the IPC JSON description */
+    FIELD_JSON = 1 << 1,
+    /* Printed by the CLI, must be a subset of FIELD_WIRE */
+    FIELD_CLI  = 1 << 2,
+    FIELD_ALL  = FIELD_WIRE | FIELD_JSON | FIELD_CLI,
+    /* Needed to filter and aggregate views, see view-aggregate.hpp */
+    FIELD_AGGREGATE = 1 << 3,
+};
+
+/* Wire types follow the protocol: bool is sent as int, strings as const char* */
+template<class T>
+struct default_wire_type
+{
+    using type = T;
+};
+
+template<>
+struct default_wire_type<bool>
+{
+    using type = int32_t;
+};
+
+/* The role is sent with the names the view_info event has always used */
+struct role_wire_t
+{};
+
+static inline const char *role_to_wire(std::string_view role)
+{
+    if (role == "toplevel")
+    {
+        return "TOPLEVEL";
+    } else if (role == "unmanaged")
+    {
+        return "UNMANAGED";
+    } else if (role == "desktop-environment")
+    {
+        return "DESKTOP_ENVIRONMENT";
+    }
+
+    return "UNKNOWN";
+}
+
+template<class T, class W = typename default_wire_type<T>::type>
+struct field_t
+{
+    using value_type = T;
+    using wire_type  = W;
+
+    /* JSON key */
+    std::string_view key;
+    /* CLI label */
+    std::string_view label;
+    uint32_t flags;
+    T view_info_t::*member;
+};
+
+inline constexpr auto view_fields = std::make_tuple(
+    field_t<uint32_t>{"id", "View ID", FIELD_ALL, &view_info_t::id},
+    field_t<int32_t>{"pid", "Client PID", FIELD_ALL | FIELD_AGGREGATE, &view_info_t::pid},
+    field_t<std::optional<info_point_t>>{"workspace", "Workspace", FIELD_ALL | FIELD_AGGREGATE, &view_info_t::workspace},
+    field_t<std::string_view>{"app-id", "App ID", FIELD_ALL | FIELD_AGGREGATE, &view_info_t::app_id},
+    field_t<std::string_view>{"title", "Title", FIELD_ALL, &view_info_t::title},
+    field_t<std::string_view, role_wire_t>{"role", "Role", FIELD_ALL | FIELD_AGGREGATE, &view_info_t::role},
+    field_t<info_rect_t>{"geometry", "Geometry", FIELD_ALL | FIELD_AGGREGATE, &view_info_t::geometry},
+    field_t<bool>{"xwayland", "Xwayland", FIELD_ALL, &view_info_t::xwayland},
+    field_t<bool>{"focused", "Focused", FIELD_ALL, &view_info_t::focused},
+    /* Printed by the CLI on one line with the pid, see print_view_info() */
+    field_t<std::string_view>{"output-name", "Output", FIELD_WIRE | FIELD_JSON, &view_info_t::output_name},
+    field_t<int32_t, uint32_t>{"output-id", "Output ID", FIELD_WIRE | FIELD_JSON | FIELD_AGGREGATE,
+        &view_info_t::output_id},
+    field_t<info_rect_t>{"base-geometry", "Base geometry", FIELD_JSON, &view_info_t::base_geometry},
+    field_t<info_rect_t>{"bbox", "Bounding box", FIELD_JSON, &view_info_t::bbox},
+    field_t<int32_t>{"parent", "Parent ID", FIELD_JSON, &view_info_t::parent},
+    field_t<int64_t>{"last-focus-timestamp", "Last focus", FIELD_JSON, &view_info_t::last_focus_timestamp},
+    field_t<bool>{"mapped", "Mapped", FIELD_JSON | FIELD_AGGREGATE, &view_info_t::mapped},
+    field_t<std::string_view>{"layer", "Layer", FIELD_JSON, &view_info_t::layer},
+    field_t<uint32_t>{"tiled-edges", "Tiled edges", FIELD_JSON, &view_info_t::tiled_edges},
+    field_t<bool>{"fullscreen", "Fullscreen", FIELD_JSON | FIELD_AGGREGATE, &view_info_t::fullscreen},
+    field_t<bool>{"minimized", "Minimized", FIELD_JSON | FIELD_AGGREGATE, &view_info_t::minimized},
+    field_t<bool>{"activated", "Activated", FIELD_JSON, &view_info_t::activated},
+    field_t<bool>{"sticky", "Sticky", FIELD_JSON, &view_info_t::sticky},
+    field_t<int64_t>{"wset-index", "Workspace set", FIELD_JSON, &view_info_t::wset_index},
+    field_t<info_size_t>{"min-size", "Min size", FIELD_JSON, &view_info_t::min_size},
+    field_t<info_size_t>{"max-size", "Max size", FIELD_JSON, &view_info_t::max_size},
+    field_t<bool>{"focusable", "Focusable", FIELD_JSON, &view_info_t::focusable},
+    field_t<std::string_view>{"type", "Type", FIELD_JSON, &view_info_t::type});
+
+/* Args of the view_info event in wayfire-information.xml, in order */
+inline constexpr std::string_view view_info_wire_keys[] = {
+    "id", "pid", "workspace", "app-id", "title", "role", "geometry", "xwayland",
+    "focused", "output-name", "output-id",
+};
+
+static constexpr size_t NUM_VIEW_FIELDS = std::tuple_size_v<std::decay_t<decltype(view_fields)>>;
+
+namespace view_fields_detail
+{
+template<size_t... I>
+constexpr bool has_field(std::string_view key, uint32_t mask, std::index_sequence<I...>)
+{
+    return ((std::get<I>(view_fields).key == key && (std::get<I>(view_fields).flags & mask)) || ...);
+}
+
+template<size_t... I>
+constexpr bool wire_order_matches(std::index_sequence<I...>)
+{
+    size_t next = 0;
+    bool matches = true;
+    ((matches = matches && (!(std::get<I>(view_fields).flags & FIELD_WIRE) ||
+        ((next < std::size(view_info_wire_keys)) &&
+         (std::get<I>(view_fields).key == view_info_wire_keys[next++])))), ...);
+    return matches && (next == std::size(view_info_wire_keys));
+}
+
+template<size_t... I>
+constexpr bool cli_is_wire(std::index_sequence<I...>)
+{
+    return (((std::get<I>(view_fields).flags & FIELD_CLI) == 0 ||
+             (std::get<I>(view_fields).flags & FIELD_WIRE)) && ...);
+}
+
+/* Conversion of a field to and from its protocol args */
+template<class T, class W>
+struct wire_codec
+{
+    static constexpr size_t arity = 1;
+    static auto encode(const T& value)
+    {
+        return std::tuple<W>(W(value));
+    }
+
+    template<size_t O, class Tuple>
+    static void decode(T& value, const Tuple& args)
+    {
+        value = T(std::get<O>(args));
+    }
+};
+
+template<class W>
+struct wire_codec<std::string_view, W>
+{
+    static constexpr size_t arity = 1;
+    /* Relies on the NUL terminator view_info_t guarantees */
+    static auto encode(const std::string_view& value)
+    {
+        assert(value.data() && (value.data()[value.size()] == '\0'));
+        return std::tuple<const char*>(value.data());
+    }
+
+    /* Only valid while the args are */
+    template<size_t O, class Tuple>
+    static void decode(std::string_view& value, const Tuple& args)
+    {
+        value = std::get<O>(args);
+    }
+};
+
+/* Decoding keeps the wire name, which is what the CLI prints */
+template<>
+struct wire_codec<std::string_view, role_wire_t>
+{
+    static constexpr size_t arity = 1;
+    static auto encode(const std::string_view& value)
+    {
+        return std::tuple<const char*>(role_to_wire(value));
+    }
+
+    template<size_t O, class Tuple>
+    static void decode(std::string_view& value, const Tuple& args)
+    {
+        value = std::get<O>(args);
+    }
+};
+
+template<class W>
+struct wire_codec<std::optional<info_point_t>, W>
+{
+    static constexpr size_t arity = 2;
+    static auto encode(const std::optional<info_point_t>& value)
+    {
+        auto p = value.value_or(info_point_t{0, 0});
+        return std::tuple<int32_t, int32_t>(p.x, p.y);
+    }
+
+    template<size_t O, class Tuple>
+    static void decode(std::optional<info_point_t>& value, const Tuple& args)
+    {
+        value = info_point_t{std::get<O>(args), std::get<O + 1>(args)};
+    }
+};
+
+template<class W>
+struct wire_codec<info_rect_t, W>
+{
+    static constexpr size_t arity = 4;
+    static auto encode(const info_rect_t& r)
+    {
+        return std::tuple<int32_t, int32_t, int32_t, int32_t>(r.x, r.y, r.width, r.height);
+    }
+
+    template<size_t O, class Tuple>
+    static void decode(info_rect_t& r, const Tuple& args)
+    {
+        r = {std::get<O>(args), std::get<O + 1>(args), std::get<O + 2>(args), std::get<O + 3>(args)};
+    }
+};
+
+template<size_t I>
+using field_type = std::decay_t<decltype(std::get<I>(view_fields))>;
+
+template<size_t I>
+using field_codec = wire_codec<typename field_type<I>::value_type, typename field_type<I>::wire_type>;
+
+template<uint32_t Mask, size_t I>
+auto field_to_wire(const view_info_t& info)
+{
+    constexpr auto& field = std::get<I>(view_fields);
+    if constexpr ((field.flags & Mask) != 0)
+    {
+        return field_codec<I>::encode(info.*(field.member));
+    } else
+    {
+        return std::tuple<>{};
+    }
+}
+
+template<uint32_t Mask, size_t... I>
+auto to_wire(const view_info_t& info, std::index_sequence<I...>)
+{
+    return std::tuple_cat(field_to_wire<Mask, I>(info)...);
+}
+
+/* Index of the first protocol arg of field I */
+template<uint32_t Mask, size_t I>
+constexpr size_t wire_offset()
+{
+    if constexpr (I == 0)
+    {
+        return 0;
+    } else
+    {
+        constexpr bool prev = (std::get<I - 1>(view_fields).flags & Mask) != 0;
+        return wire_offset<Mask, I - 1>() + (prev ? field_codec<I - 1>::arity : 0);
+    }
+}
+
+template<uint32_t Mask, class Tuple, size_t... I>
+void from_wire(view_info_t& info, const Tuple& args, std::index_sequence<I...>)
+{
+    ([&]
+    {
+        constexpr auto& field = std::get<I>(view_fields);
+        if constexpr ((field.flags & Mask) != 0)
+        {
+            field_codec<I>::template decode<wire_offset<Mask, I>()>(info.*(field.member), args);
+        }
+    }(), ...);
+}
+
+template<uint32_t Mask, class F, size_t... I>
+void for_each_field(const view_info_t& info, F&& callback, std::index_sequence<I...>)
+{
+    ([&]
+    {
+        constexpr auto& field = std::get<I>(view_fields);
+        if constexpr ((field.flags & Mask) != 0)
+        {
+            callback(field, info.*(field.member));
+        }
+    }(), ...);
+}
+}
+
+static_assert(view_fields_detail::wire_order_matches(std::make_index_sequence<NUM_VIEW_FIELDS>{}),
+    "FIELD_WIRE fields must be in the order of the view_info event args");
+static_assert(view_fields_detail::cli_is_wire(std::make_index_sequence<NUM_VIEW_FIELDS>{}),
+    "CLI fields are decoded from the Wayland event and must be FIELD_WIRE");
+
+/* Whether the field named key is selected by mask, usable in if constexpr */
+template<uint32_t Mask>
+constexpr bool view_field_enabled(std::string_view key)
+{
+    return view_fields_detail::has_field(key, Mask, std::make_index_sequence<NUM_VIEW_FIELDS>{});
+}
+
+/* Call callback(field, value) for each field selected by Mask, in table order */
+template<uint32_t Mask, class F>
+void for_each_view_field(const view_info_t& info, F&& callback)
+{
+    view_fields_detail::for_each_field<Mask>(info, std::forward<F>(callback),
+        std::make_index_sequence<NUM_VIEW_FIELDS>{});
+}
+
+/* Protocol args of the view_info event, strings point into info */
+static inline auto view_info_to_wire(const view_info_t& info)
+{
+    return view_fields_detail::to_wire<FIELD_WIRE>(info, std::make_index_sequence<NUM_VIEW_FIELDS>{});
+}
+
+using view_info_wire_t = decltype(view_info_to_wire(std::declval<const view_info_t&>()));
+
+/* Inverse of view_info_to_wire(), string_view fields point into args */
+template<class... Args>
+view_info_t view_info_from_wire(Args... args)
+{
+    static_assert(std::is_same_v<std::tuple<Args...>, view_info_wire_t>,
+        "view_info args do not match view_fields");
+
+    view_info_t info;
+    view_fields_detail::from_wire<FIELD_WIRE>(info, std::tuple<Args...>(args...),
+        std::make_index_sequence<NUM_VIEW_FIELDS>{});
+    return info;
+}
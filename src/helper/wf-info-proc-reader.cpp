@@ -0,0 +1,187 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+ * Reads process details from /proc for the wf-info plugin. Reading some of
+ * these files waits for locks of the target process, which can take
+ * arbitrarily long, so the plugin does it in this separate process, which it
+ * can always kill. The socket to the plugin is fd 3, see process-record.hpp.
+ */
+
+#include <fcntl.h>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <algorithm>
+#include <sys/socket.h>
+
+#include "process-record.hpp"
+
+static constexpr int SOCKET_FD = 3;
+
+static std::string read_proc_file(pid_t pid, const char *name)
+{
+    std::string path = "/proc/" + std::to_string(pid) + "/" + name;
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return "";
+    }
+
+    std::string contents;
+    char buf[4096];
+    ssize_t len;
+    while ((len = read(fd, buf, sizeof(buf))) > 0)
+    {
+        contents.append(buf, len);
+    }
+
+    close(fd);
+    return contents;
+}
+
+static uint64_t parse_status_field(const std::string& status, const char *field)
+{
+    auto pos = status.find(field);
+    if (pos == std::string::npos)
+    {
+        return 0;
+    }
+
+    return strtoull(status.c_str() + pos + strlen(field), nullptr, 10);
+}
+
+static process_record_t read_process_info(pid_t pid)
+{
+    process_record_t info;
+    info.pid = pid;
+
+    std::string status = read_proc_file(pid, "status");
+    if (status.empty())
+    {
+        return info;
+    }
+
+    info.valid  = true;
+    info.ppid   = parse_status_field(status, "\nPPid:");
+    info.rss_kb = parse_status_field(status, "\nVmRSS:");
+
+    char exe[PATH_MAX];
+    std::string exe_path = "/proc/" + std::to_string(pid) + "/exe";
+    ssize_t len = readlink(exe_path.c_str(), exe, sizeof(exe) - 1);
+    if (len > 0)
+    {
+        info.executable.assign(exe, len);
+    }
+
+    info.cmdline = read_proc_file(pid, "cmdline");
+    while (!info.cmdline.empty() && (info.cmdline.back() == '\0'))
+    {
+        info.cmdline.pop_back();
+    }
+
+    std::replace(info.cmdline.begin(), info.cmdline.end(), '\0', ' ');
+
+    /* utime and stime are the 14th and 15th fields, comm may contain spaces
+     * and parentheses so start after the last ')' */
+    std::string stat = read_proc_file(pid, "stat");
+    auto comm_end    = stat.rfind(')');
+    if (comm_end != std::string::npos)
+    {
+        const char *p = stat.c_str() + comm_end + 1;
+        char *end;
+        uint64_t ticks = 0;
+        for (int field = 3; field <= 15; field++)
+        {
+            uint64_t value = strtoull(p, &end, 10);
+            if ((field != 3) && (end == p))
+            {
+                break;
+            }
+
+            if (field >= 14)
+            {
+                ticks += value;
+            }
+
+            /* field 3 (state) is a character */
+            p = (field == 3) ? strchr(p + 1, ' ') : end;
+            if (!p)
+            {
+                break;
+            }
+        }
+
+        info.cpu_time_ms = ticks * 1000 / sysconf(_SC_CLK_TCK);
+    }
+
+    /* Use the unified hierarchy entry ("0::/path") if there is one */
+    std::string cgroup = read_proc_file(pid, "cgroup");
+    auto unified = cgroup.find("0::");
+    if (unified != std::string::npos)
+    {
+        info.cgroup = cgroup.substr(unified + 3, cgroup.find('\n', unified) - unified - 3);
+    } else
+    {
+        info.cgroup = cgroup.substr(0, cgroup.find('\n'));
+    }
+
+    return info;
+}
+
+int main()
+{
+    std::string reply;
+    while (true)
+    {
+        int32_t pid;
+        ssize_t len = recv(SOCKET_FD, &pid, sizeof(pid), 0);
+        if ((len < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+
+        /* The plugin closed the socket */
+        if (len <= 0)
+        {
+            break;
+        }
+
+        if ((len != sizeof(pid)) || (pid <= 0))
+        {
+            continue;
+        }
+
+        encode_process_record(reply, read_process_info(pid));
+        if (send(SOCKET_FD, reply.data(), reply.size(), MSG_NOSIGNAL) < 0)
+        {
+            break;
+        }
+    }
+
+    return 0;
+}
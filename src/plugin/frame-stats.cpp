@@ -0,0 +1,298 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <algorithm>
+#include <wayfire/nonstd/wlroots-full.hpp>
+
+#include "frame-stats.hpp"
+#include "timing.hpp"
+
+int frame_histogram_t::bucket_for(uint64_t us)
+{
+    if (us < SUB_BUCKETS)
+    {
+        return us;
+    }
+
+    int msb = 63 - __builtin_clzll(us);
+    int sub = (us >> (msb - SUB_BITS)) & (SUB_BUCKETS - 1);
+    return std::min((msb - SUB_BITS + 1) * SUB_BUCKETS + sub, NUM_BUCKETS - 1);
+}
+
+uint64_t frame_histogram_t::bucket_max(int bucket)
+{
+    if (bucket < SUB_BUCKETS)
+    {
+        return bucket;
+    }
+
+    int exp = bucket / SUB_BUCKETS;
+    int sub = bucket % SUB_BUCKETS;
+    return (uint64_t(SUB_BUCKETS + sub + 1) << (exp - 1)) - 1;
+}
+
+void frame_histogram_t::add(uint64_t us)
+{
+    buckets[bucket_for(us)]++;
+    count++;
+    sum_us += us;
+    min_us  = std::min(min_us, us);
+    max_us  = std::max(max_us, us);
+}
+
+void frame_histogram_t::merge(const frame_histogram_t& other)
+{
+    for (int i = 0; i < NUM_BUCKETS; i++)
+    {
+        buckets[i] += other.buckets[i];
+    }
+
+    count  += other.count;
+    sum_us += other.sum_us;
+    min_us  = std::min(min_us, other.min_us);
+    max_us  = std::max(max_us, other.max_us);
+}
+
+void frame_histogram_t::reset()
+{
+    *this = frame_histogram_t{};
+}
+
+uint64_t frame_histogram_t::average() const
+{
+    return count ? sum_us / count : 0;
+}
+
+uint64_t frame_histogram_t::percentile(double p) const
+{
+    if (!count)
+    {
+        return 0;
+    }
+
+    uint64_t target = std::max<uint64_t>(1, p * count);
+    uint64_t seen   = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++)
+    {
+        seen += buckets[i];
+        if (seen >= target)
+        {
+            return std::min(bucket_max(i), max_us);
+        }
+    }
+
+    return max_us;
+}
+
+wf::json_t frame_histogram_t::to_json() const
+{
+    wf::json_t response;
+    response["count"]  = count;
+    response["min-us"] = count ? min_us : 0;
+    response["max-us"] = max_us;
+    response["avg-us"] = average();
+    response["p50-us"] = percentile(0.50);
+    response["p90-us"] = percentile(0.90);
+    response["p99-us"] = percentile(0.99);
+    response["buckets"] = wf::json_t::array();
+    for (int i = 0; i < NUM_BUCKETS; i++)
+    {
+        if (!buckets[i])
+        {
+            continue;
+        }
+
+        wf::json_t bucket;
+        /* The last bucket also holds everything above it */
+        bucket["le-us"] = (i == NUM_BUCKETS - 1) ? max_us : bucket_max(i);
+        bucket["count"] = uint64_t(buckets[i]);
+        response["buckets"].append(bucket);
+    }
+
+    return response;
+}
+
+void frame_stats_slice_t::merge(const frame_stats_slice_t& other)
+{
+    frame_time.merge(other.frame_time);
+    render_time.merge(other.render_time);
+    frames    += other.frames;
+    presented += other.presented;
+    dropped   += other.dropped;
+    missed    += other.missed;
+}
+
+frame_stats_slice_t& frame_stats_window_t::at(uint64_t now_ns)
+{
+    uint64_t slice = now_ns / SLICE_NS;
+    /* Slightly older timestamps, such as presentation times, go into the
+     * newest slice */
+    if (slice > newest)
+    {
+        uint64_t stale = std::min<uint64_t>(slice - newest, NUM_SLICES);
+        for (uint64_t i = 1; i <= stale; i++)
+        {
+            slices[(newest + i) % NUM_SLICES] = {};
+        }
+
+        newest = slice;
+    }
+
+    return slices[newest % NUM_SLICES];
+}
+
+frame_stats_slice_t frame_stats_window_t::summary(uint64_t now_ns) const
+{
+    frame_stats_slice_t summary;
+    uint64_t slice = std::max(now_ns / SLICE_NS, newest);
+    for (int i = 0; i < NUM_SLICES; i++)
+    {
+        /* Slices which have not been rotated out yet may be too old */
+        if ((newest >= uint64_t(i)) && (slice - (newest - i) < NUM_SLICES))
+        {
+            summary.merge(slices[(newest - i) % NUM_SLICES]);
+        }
+    }
+
+    return summary;
+}
+
+void frame_stats_window_t::reset()
+{
+    slices.fill({});
+    newest = 0;
+}
+
+output_frame_stats_t::output_frame_stats_t(wf::output_t *output)
+{
+    this->output = output;
+
+    on_frame.set_callback([=] (void*)
+    {
+        last_frame_ns = get_monotonic_ns();
+    });
+    on_frame.connect(&output->handle->events.frame);
+
+    on_render_done = [=] ()
+    {
+        uint64_t now = get_monotonic_ns();
+        auto& slice  = window.at(now);
+        slice.frames++;
+        if (last_frame_ns)
+        {
+            slice.render_time.add((now - last_frame_ns) / 1000);
+        }
+
+        rendered_frame_ns = last_frame_ns;
+    };
+    output->render->add_effect(&on_render_done, wf::OUTPUT_EFFECT_POST);
+
+    on_present.set_callback([=] (void *data)
+    {
+        auto ev = (wlr_output_event_present*)data;
+        uint64_t when = timespec_to_ns(ev->when);
+        if (!when)
+        {
+            when = get_monotonic_ns();
+        }
+
+        auto& slice = window.at(when);
+        if (!ev->presented)
+        {
+            slice.dropped++;
+            return;
+        }
+
+        uint64_t refresh_ns = ev->refresh > 0 ? uint64_t(ev->refresh) : get_refresh_ns();
+        slice.presented++;
+
+        /* The output rendered continuously if the frame was started by the
+         * frame event of the previous presentation, otherwise it was idle and
+         * started by new damage. */
+        uint64_t period = refresh_ns ? refresh_ns : 1000000000ull / 60;
+        uint64_t start  = rendered_frame_ns;
+        if (last_present_ns && (rendered_frame_ns < last_present_ns + period))
+        {
+            start = last_present_ns;
+        }
+
+        if (start && (when > start))
+        {
+            uint64_t interval = when - start;
+            slice.frame_time.add(interval / 1000);
+            if (refresh_ns && (2 * interval > 3 * refresh_ns))
+            {
+                slice.missed += (interval + refresh_ns / 2) / refresh_ns - 1;
+            }
+        }
+
+        last_present_ns = when;
+    });
+    on_present.connect(&output->handle->events.present);
+}
+
+output_frame_stats_t::~output_frame_stats_t()
+{
+    output->render->rem_effect(&on_render_done);
+}
+
+uint64_t output_frame_stats_t::get_refresh_ns() const
+{
+    /* wlr_output::refresh is in mHz */
+    if (output->handle->refresh <= 0)
+    {
+        return 0;
+    }
+
+    return 1000000000000ull / output->handle->refresh;
+}
+
+frame_stats_slice_t output_frame_stats_t::summary() const
+{
+    return window.summary(get_monotonic_ns());
+}
+
+void output_frame_stats_t::reset()
+{
+    window.reset();
+    last_present_ns = 0;
+}
+
+wf::json_t output_frame_stats_t::to_json() const
+{
+    auto stats = summary();
+    wf::json_t response;
+    response["output-id"]   = output->get_id();
+    response["output-name"] = output->to_string();
+    response["refresh-ns"]  = get_refresh_ns();
+    response["window-ms"]   = uint64_t(frame_stats_window_t::NUM_SLICES * frame_stats_window_t::SLICE_NS / 1000000);
+    response["frames"]    = stats.frames;
+    response["presented"] = stats.presented;
+    response["dropped"]   = stats.dropped;
+    response["missed"]    = stats.missed;
+    response["frame-time"]  = stats.frame_time.to_json();
+    response["render-time"] = stats.render_time.to_json();
+    return response;
+}
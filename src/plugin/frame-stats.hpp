@@ -0,0 +1,135 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <wayfire/util.hpp>
+#include <wayfire/output.hpp>
+#include <wayfire/render-manager.hpp>
+#include <wayfire/nonstd/json.hpp>
+
+/*
+ * Log-linear histogram of durations in microseconds. Each power of two is
+ * split into SUB_BUCKETS linear buckets, which keeps the relative error
+ * below 25% while staying small enough to update on every frame.
+ */
+struct frame_histogram_t
+{
+    static constexpr int SUB_BITS    = 2;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr int NUM_BUCKETS = 100;
+
+    std::array<uint32_t, NUM_BUCKETS> buckets{};
+    uint64_t count  = 0;
+    uint64_t sum_us = 0;
+    uint64_t min_us = UINT64_MAX;
+    uint64_t max_us = 0;
+
+    static int bucket_for(uint64_t us);
+    /* Largest value which falls into bucket, inclusive */
+    static uint64_t bucket_max(int bucket);
+
+    void add(uint64_t us);
+    void merge(const frame_histogram_t& other);
+    void reset();
+    uint64_t average() const;
+    uint64_t percentile(double p) const;
+    wf::json_t to_json() const;
+};
+
+/* Frame statistics of one slice of time */
+struct frame_stats_slice_t
+{
+    frame_histogram_t frame_time;
+    frame_histogram_t render_time;
+    uint64_t frames    = 0;
+    uint64_t presented = 0;
+    uint64_t dropped   = 0;
+    uint64_t missed    = 0;
+
+    void merge(const frame_stats_slice_t& other);
+};
+
+/*
+ * Rolling window of frame statistics: a ring of NUM_SLICES slices of
+ * SLICE_NS each. Events go into the slice of their timestamp and slices are
+ * only merged when read, so recording stays O(1).
+ */
+class frame_stats_window_t
+{
+  public:
+    static constexpr int NUM_SLICES = 10;
+    static constexpr uint64_t SLICE_NS = 1000000000ull;
+
+  private:
+    std::array<frame_stats_slice_t, NUM_SLICES> slices;
+    /* Absolute slice number (timestamp / SLICE_NS) of the newest slice */
+    uint64_t newest = 0;
+
+  public:
+    /* Slice to record an event at now_ns into */
+    frame_stats_slice_t& at(uint64_t now_ns);
+    /* Everything recorded during the window ending at now_ns */
+    frame_stats_slice_t summary(uint64_t now_ns) const;
+    void reset();
+};
+
+/*
+ * Per-output frame timing over the last few seconds. Only a timestamp is
+ * taken on the frame event and the render hook, the present event brings its
+ * own, everything else is bucket arithmetic.
+ *
+ * frame-time is the time from the previous presentation to a presentation
+ * while the output is continuously rendering. When an idle output (no
+ * damage) starts rendering again, it is measured from the frame event which
+ * started the render instead, so idle time is not counted. render-time is the
+ * time from the frame event (vblank) until the render manager finished
+ * painting the frame.
+ */
+class output_frame_stats_t
+{
+    wf::output_t *output;
+    wf::wl_listener_wrapper on_frame;
+    wf::wl_listener_wrapper on_present;
+    wf::effect_hook_t on_render_done;
+
+    uint64_t last_frame_ns     = 0;
+    /* Frame event which started the last rendered frame */
+    uint64_t rendered_frame_ns = 0;
+    uint64_t last_present_ns   = 0;
+
+    uint64_t get_refresh_ns() const;
+
+  public:
+    frame_stats_window_t window;
+
+    output_frame_stats_t(wf::output_t *output);
+    ~output_frame_stats_t();
+
+    frame_stats_slice_t summary() const;
+    void reset();
+    wf::json_t to_json() const;
+};
@@ -8,6 +8,9 @@
 #include <wayfire/nonstd/wlroots-full.hpp>
 #include <wayfire/unstable/wlr-surface-node.hpp>
 #include <wayfire/view-helpers.hpp>
+#include "view-lifecycle.hpp"
+#include "info-core.hpp"
+#include "view-aggregate.hpp"
 
 static inline wf::json_t output_to_json(wf::output_t *o)
 {
@@ -52,6 +55,16 @@ static inline pid_t get_view_pid(wayfire_view view)
     return pid; // NOLINT
 }
 
+static inline bool is_xwayland_view(wayfire_view view)
+{
+#if WF_HAS_XWAYLAND
+    wlr_surface *wlr_surface = view->get_wlr_surface();
+    return wlr_surface && wlr_xwayland_surface_try_from_wlr_surface(wlr_surface);
+#else
+    return false;
+#endif
+}
+
 static inline wf::geometry_t get_view_base_geometry(wayfire_view view)
 {
     auto sroot = view->get_surface_root_node();
@@ -70,7 +83,18 @@ static inline wf::geometry_t get_view_base_geometry(wayfire_view view)
     return sroot->get_bounding_box();
 }
 
-static inline std::string role_to_string(enum wf::view_role_t role)
+/* Workspace of the output's wset which contains the center of the view */
+static inline wf::point_t get_view_workspace(wayfire_view view, wf::output_t *output)
+{
+    auto og = output->get_screen_size();
+    auto ws = output->wset()->get_current_workspace();
+    auto wm = wf::view_bounding_box_up_to(view);
+    auto workspace = compute_workspace({wm.x, wm.y, wm.width, wm.height},
+        {og.width, og.height}, {ws.x, ws.y});
+    return {workspace.x, workspace.y};
+}
+
+static inline std::string_view role_to_string(enum wf::view_role_t role)
 {
     switch (role)
     {
@@ -88,7 +112,7 @@ static inline std::string role_to_string(enum wf::view_role_t role)
     }
 }
 
-static inline std::string layer_to_string(std::optional<wf::scene::layer> layer)
+static inline std::string_view layer_to_string(std::optional<wf::scene::layer> layer)
 {
     if (!layer.has_value())
     {
@@ -129,7 +153,7 @@ static inline std::string layer_to_string(std::optional<wf::scene::layer> layer)
     assert(false); // prevent compiler warning
 }
 
-static inline std::string get_view_type(wayfire_view view)
+static inline std::string_view get_view_type(wayfire_view view)
 {
     if (view->role == wf::VIEW_ROLE_TOPLEVEL)
     {
@@ -165,6 +189,229 @@ static inline std::string get_view_type(wayfire_view view)
     return "unknown";
 }
 
+static inline info_rect_t to_info_rect(wf::geometry_t g)
+{
+    return {g.x, g.y, g.width, g.height};
+}
+
+static inline info_size_t to_info_size(wf::dimensions_t d)
+{
+    return {d.width, d.height};
+}
+
+/*
+ * Strings of a view_info_t which cannot be borrowed from the view, because
+ * Wayfire only returns them by value. Keep it alive as long as the info.
+ */
+struct view_info_strings_t
+{
+    std::string app_id;
+    std::string title;
+};
+
+/*
+ * Fill the fields of view_fields selected by Mask. Fields which are not
+ * selected are not computed at all.
+ */
+template<uint32_t Mask>
+static inline view_info_t extract_view_info(wayfire_view view, view_info_strings_t& strings)
+{
+    view_info_t info;
+    auto output   = view->get_output();
+    auto toplevel = wf::toplevel_cast(view);
+
+    info.id = view->get_id();
+    if constexpr (view_field_enabled<Mask>("pid"))
+    {
+        info.pid = get_view_pid(view);
+    }
+
+    if constexpr (view_field_enabled<Mask>("workspace"))
+    {
+        if (output)
+        {
+            auto ws = get_view_workspace(view, output);
+            info.workspace = info_point_t{ws.x, ws.y};
+        }
+    }
+
+    if constexpr (view_field_enabled<Mask>("app-id"))
+    {
+        strings.app_id = view->get_app_id();
+        info.app_id    = strings.app_id;
+    }
+
+    if constexpr (view_field_enabled<Mask>("title"))
+    {
+        strings.title = view->get_title();
+        info.title    = strings.title;
+    }
+
+    if constexpr (view_field_enabled<Mask>("role"))
+    {
+        info.role = role_to_string(view->role);
+    }
+
+    if constexpr (view_field_enabled<Mask>("geometry"))
+    {
+        info.geometry = to_info_rect(toplevel ? toplevel->get_pending_geometry() : view->get_bounding_box());
+    }
+
+    if constexpr (view_field_enabled<Mask>("xwayland"))
+    {
+        info.xwayland = is_xwayland_view(view);
+    }
+
+    if constexpr (view_field_enabled<Mask>("focused"))
+    {
+        info.focused = output && (wf::get_active_view_for_output(output) == view);
+    }
+
+    if constexpr (view_field_enabled<Mask>("output-name"))
+    {
+        info.output_name = output ? output->handle->name : "null";
+    }
+
+    if constexpr (view_field_enabled<Mask>("output-id"))
+    {
+        info.output_id = output ? (int32_t)output->get_id() : -1;
+    }
+
+    if constexpr (view_field_enabled<Mask>("base-geometry"))
+    {
+        info.base_geometry = to_info_rect(get_view_base_geometry(view));
+    }
+
+    if constexpr (view_field_enabled<Mask>("bbox"))
+    {
+        info.bbox = to_info_rect(view->get_bounding_box());
+    }
+
+    if constexpr (view_field_enabled<Mask>("parent"))
+    {
+        info.parent = toplevel && toplevel->parent ? (int32_t)toplevel->parent->get_id() : -1;
+    }
+
+    if constexpr (view_field_enabled<Mask>("last-focus-timestamp"))
+    {
+        info.last_focus_timestamp = wf::get_focus_timestamp(view);
+    }
+
+    if constexpr (view_field_enabled<Mask>("mapped"))
+    {
+        info.mapped = view->is_mapped();
+    }
+
+    if constexpr (view_field_enabled<Mask>("layer"))
+    {
+        info.layer = layer_to_string(get_view_layer(view));
+    }
+
+    if (toplevel)
+    {
+        if constexpr (view_field_enabled<Mask>("tiled-edges"))
+        {
+            info.tiled_edges = toplevel->pending_tiled_edges();
+        }
+
+        if constexpr (view_field_enabled<Mask>("fullscreen"))
+        {
+            info.fullscreen = toplevel->pending_fullscreen();
+        }
+
+        if constexpr (view_field_enabled<Mask>("minimized"))
+        {
+            info.minimized = toplevel->minimized;
+        }
+
+        if constexpr (view_field_enabled<Mask>("activated"))
+        {
+            info.activated = toplevel->activated;
+        }
+
+        if constexpr (view_field_enabled<Mask>("sticky"))
+        {
+            info.sticky = toplevel->sticky;
+        }
+
+        if constexpr (view_field_enabled<Mask>("wset-index"))
+        {
+            info.wset_index = toplevel->get_wset() ? (int64_t)toplevel->get_wset()->get_index() : -1;
+        }
+
+        if constexpr (view_field_enabled<Mask>("min-size"))
+        {
+            info.min_size = to_info_size(toplevel->toplevel()->get_min_size());
+        }
+
+        if constexpr (view_field_enabled<Mask>("max-size"))
+        {
+            info.max_size = to_info_size(toplevel->toplevel()->get_max_size());
+        }
+    }
+
+    if constexpr (view_field_enabled<Mask>("focusable"))
+    {
+        info.focusable = view->is_focusable();
+    }
+
+    if constexpr (view_field_enabled<Mask>("type"))
+    {
+        info.type = get_view_type(view);
+    }
+
+    return info;
+}
+
+static inline wf::json_t field_to_json(int32_t value)
+{
+    return (int)value;
+}
+
+static inline wf::json_t field_to_json(uint32_t value)
+{
+    return (uint64_t)value;
+}
+
+static inline wf::json_t field_to_json(int64_t value)
+{
+    return value;
+}
+
+static inline wf::json_t field_to_json(bool value)
+{
+    return value;
+}
+
+/* wf::json_t only stores std::string */
+static inline wf::json_t field_to_json(std::string_view value)
+{
+    return std::string(value);
+}
+
+static inline wf::json_t field_to_json(const info_rect_t& r)
+{
+    return wf::ipc::geometry_to_json({r.x, r.y, r.width, r.height});
+}
+
+static inline wf::json_t field_to_json(const info_size_t& s)
+{
+    return wf::ipc::dimensions_to_json({s.width, s.height});
+}
+
+static inline wf::json_t field_to_json(const std::optional<info_point_t>& p)
+{
+    if (!p)
+    {
+        return wf::json_t::null();
+    }
+
+    wf::json_t response;
+    response["x"] = p->x;
+    response["y"] = p->y;
+    return response;
+}
+
 static inline wf::json_t view_to_json(wayfire_view view)
 {
     if (!view)
@@ -172,38 +419,17 @@ static inline wf::json_t view_to_json(wayfire_view view)
         return wf::json_t::null();
     }
 
-    auto output = view->get_output();
     wf::json_t description;
-    description["id"]     = view->get_id();
-    description["pid"]    = get_view_pid(view);
-    description["title"]  = view->get_title();
-    description["app-id"] = view->get_app_id();
-    description["base-geometry"] = wf::ipc::geometry_to_json(get_view_base_geometry(view));
-    auto toplevel = wf::toplevel_cast(view);
-    description["parent"]   = toplevel && toplevel->parent ? (int)toplevel->parent->get_id() : -1;
-    description["geometry"] =
-        wf::ipc::geometry_to_json(toplevel ? toplevel->get_pending_geometry() : view->get_bounding_box());
-    description["bbox"] = wf::ipc::geometry_to_json(view->get_bounding_box());
-    description["output-id"]   = view->get_output() ? view->get_output()->get_id() : -1;
-    description["output-name"] = output ? output->to_string() : "null";
-    description["last-focus-timestamp"] = wf::get_focus_timestamp(view);
-    description["role"]   = role_to_string(view->role);
-    description["mapped"] = view->is_mapped();
-    description["layer"]  = layer_to_string(get_view_layer(view));
-    description["tiled-edges"] = toplevel ? toplevel->pending_tiled_edges() : 0;
-    description["fullscreen"]  = toplevel ? toplevel->pending_fullscreen() : false;
-    description["minimized"]   = toplevel ? toplevel->minimized : false;
-    description["activated"]   = toplevel ? toplevel->activated : false;
-    description["sticky"]     = toplevel ? toplevel->sticky : false;
-    description["wset-index"] = toplevel && toplevel->get_wset() ?
-        static_cast<int64_t>(toplevel->get_wset()->get_index()) :
-        -1;
-    description["min-size"] = wf::ipc::dimensions_to_json(
-        toplevel ? toplevel->toplevel()->get_min_size() : wf::dimensions_t{0, 0});
-    description["max-size"] = wf::ipc::dimensions_to_json(
-        toplevel ? toplevel->toplevel()->get_max_size() : wf::dimensions_t{0, 0});
-    description["focusable"] = view->is_focusable();
-    description["type"] = get_view_type(view);
+    view_info_strings_t strings;
+    auto info = extract_view_info<FIELD_JSON>(view, strings);
+    for_each_view_field<FIELD_JSON>(info, [&] (auto& field, auto& value)
+    {
+        /* keys are NUL-terminated literals */
+        description[field.key.data()] = field_to_json(value);
+    });
+
+    auto lifecycle = view->get_data<view_lifecycle_t>();
+    description["lifecycle"] = lifecycle ? lifecycle->to_json() : wf::json_t::null();
 
     return description;
 }
@@ -228,3 +454,66 @@ static inline wf::json_t wset_to_json(wf::workspace_set_t *wset)
     response["workspace"]["grid_height"] = wset->get_workspace_grid_size().height;
     return response;
 }
+
+static inline wf::json_t view_group_to_json(const view_group_stats_t& stats)
+{
+    wf::json_t response;
+    response["count"]      = (uint64_t)stats.count;
+    response["minimized"]  = (uint64_t)stats.minimized;
+    response["fullscreen"] = (uint64_t)stats.fullscreen;
+    response["area"] = stats.area;
+    return response;
+}
+
+static inline wf::json_t view_aggregate_to_json(const view_aggregate_t& aggregate)
+{
+    wf::json_t response;
+    response["total"] = view_group_to_json(aggregate.total);
+    if (aggregate.groups & GROUP_APP_ID)
+    {
+        response["app-id"] = wf::json_t::array();
+        for (auto& [app_id, stats] : aggregate.by_app_id)
+        {
+            auto group = view_group_to_json(stats);
+            group["app-id"] = app_id;
+            response["app-id"].append(group);
+        }
+    }
+
+    if (aggregate.groups & GROUP_PID)
+    {
+        response["pid"] = wf::json_t::array();
+        for (auto& [pid, stats] : aggregate.by_pid)
+        {
+            auto group = view_group_to_json(stats);
+            group["pid"] = pid;
+            response["pid"].append(group);
+        }
+    }
+
+    if (aggregate.groups & GROUP_OUTPUT)
+    {
+        response["output"] = wf::json_t::array();
+        for (auto& [output_id, stats] : aggregate.by_output)
+        {
+            auto group = view_group_to_json(stats);
+            group["output-id"] = output_id;
+            response["output"].append(group);
+        }
+    }
+
+    if (aggregate.groups & GROUP_WORKSPACE)
+    {
+        response["workspace"] = wf::json_t::array();
+        for (auto& [key, stats] : aggregate.by_workspace)
+        {
+            auto group = view_group_to_json(stats);
+            group["output-id"] = key.output_id;
+            group["x"] = key.x;
+            group["y"] = key.y;
+            response["workspace"].append(group);
+        }
+    }
+
+    return response;
+}
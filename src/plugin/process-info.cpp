@@ -0,0 +1,363 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <spawn.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstring>
+#include <signal.h>
+#include <unistd.h>
+#include <algorithm>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <wayfire/core.hpp>
+#include <wayfire/util/log.hpp>
+
+#include "process-info.hpp"
+#include "timing.hpp"
+
+extern char **environ;
+
+/* Cached entries this many TTLs old are dropped instead of refreshed */
+static constexpr uint64_t EXPIRE_TTLS = 10;
+
+wf::json_t process_info_t::to_json() const
+{
+    wf::json_t response;
+    response["pid"]   = pid;
+    response["valid"] = valid;
+    response["age-ms"] = (get_monotonic_ns() - timestamp_ns) / 1000000;
+    if (!valid)
+    {
+        return response;
+    }
+
+    response["ppid"] = ppid;
+    response["executable"] = executable;
+    response["cmdline"]    = cmdline;
+    response["cgroup"]     = cgroup;
+    response["rss-kb"]     = rss_kb;
+    response["cpu-time-ms"] = cpu_time_ms;
+    return response;
+}
+
+process_info_cache_t::process_info_cache_t()
+{
+    enabled_opt.set_callback([=] ()
+    {
+        if (enabled_opt)
+        {
+            start();
+        } else
+        {
+            stop();
+        }
+    });
+
+    if (enabled_opt)
+    {
+        start();
+    }
+}
+
+process_info_cache_t::~process_info_cache_t()
+{
+    stop();
+}
+
+void process_info_cache_t::start()
+{
+    if (active)
+    {
+        return;
+    }
+
+    timeout_timer = wl_event_loop_add_timer(wf::get_core().ev_loop, handle_timeout, this);
+    active = true;
+    if (!spawn_reader())
+    {
+        stop();
+    }
+}
+
+void process_info_cache_t::stop()
+{
+    if (!active)
+    {
+        return;
+    }
+
+    kill_reader();
+    wl_event_source_remove(timeout_timer);
+    timeout_timer = nullptr;
+    in_flight.clear();
+    queued.clear();
+    pending.clear();
+    cache.clear();
+    active = false;
+}
+
+bool process_info_cache_t::spawn_reader()
+{
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0, sv) < 0)
+    {
+        LOGE("Failed to create socket for process info");
+        return false;
+    }
+
+    /* The helper gets a blocking socket as fd 3 */
+    int flags = fcntl(sv[1], F_GETFL);
+    fcntl(sv[1], F_SETFL, flags & ~O_NONBLOCK);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, sv[1], 3);
+
+    /* The compositor may block signals the helper should get */
+    posix_spawnattr_t attr;
+    sigset_t mask;
+    sigemptyset(&mask);
+    posix_spawnattr_init(&attr);
+    posix_spawnattr_setsigmask(&attr, &mask);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK);
+
+    char *argv[] = {(char*)WF_INFO_PROC_READER, nullptr};
+    int err = posix_spawn(&reader_pid, WF_INFO_PROC_READER, &actions, &attr, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attr);
+    close(sv[1]);
+    if (err)
+    {
+        LOGE("Failed to start ", WF_INFO_PROC_READER, ": ", strerror(err));
+        reader_pid = -1;
+        close(sv[0]);
+        return false;
+    }
+
+    reader_fd     = sv[0];
+    reader_source = wl_event_loop_add_fd(wf::get_core().ev_loop, reader_fd,
+        WL_EVENT_READABLE, handle_reader, this);
+    return true;
+}
+
+void process_info_cache_t::kill_reader()
+{
+    if (reader_source)
+    {
+        wl_event_source_remove(reader_source);
+        reader_source = nullptr;
+    }
+
+    if (reader_fd >= 0)
+    {
+        close(reader_fd);
+        reader_fd = -1;
+    }
+
+    if (reader_pid > 0)
+    {
+        /* Waits for locks in /proc reads are killable, so this returns
+         * promptly even if the helper is stuck in one */
+        kill(reader_pid, SIGKILL);
+        while ((waitpid(reader_pid, nullptr, 0) < 0) && (errno == EINTR))
+        {}
+
+        reader_pid = -1;
+    }
+}
+
+void process_info_cache_t::restart_reader()
+{
+    /* Requests which were sent but not answered are sent again */
+    for (auto it = in_flight.rbegin(); it != in_flight.rend(); ++it)
+    {
+        queued.push_front(it->pid);
+    }
+
+    in_flight.clear();
+    kill_reader();
+    if (!spawn_reader())
+    {
+        stop();
+        return;
+    }
+
+    send_requests();
+}
+
+void process_info_cache_t::send_requests()
+{
+    bool was_idle = in_flight.empty();
+    while (!queued.empty() && (in_flight.size() < MAX_IN_FLIGHT))
+    {
+        int32_t pid = queued.front();
+        if (send(reader_fd, &pid, sizeof(pid), MSG_NOSIGNAL) != sizeof(pid))
+        {
+            /* Sent once replies make room */
+            break;
+        }
+
+        queued.pop_front();
+        in_flight.push_back({pid, get_monotonic_ns()});
+    }
+
+    if (was_idle)
+    {
+        arm_timeout();
+    }
+}
+
+void process_info_cache_t::arm_timeout()
+{
+    if (in_flight.empty())
+    {
+        wl_event_source_timer_update(timeout_timer, 0);
+        return;
+    }
+
+    uint64_t deadline = in_flight.front().sent_ns + REQUEST_TIMEOUT_MS * 1000000ull;
+    uint64_t now = get_monotonic_ns();
+    /* 0 would disarm the timer */
+    int ms = (deadline > now) ? std::max<int>(1, (deadline - now + 999999) / 1000000) : 1;
+    wl_event_source_timer_update(timeout_timer, ms);
+}
+
+int process_info_cache_t::handle_reader(int fd, uint32_t mask, void *data)
+{
+    auto self = (process_info_cache_t*)data;
+    if (mask & (WL_EVENT_HANGUP | WL_EVENT_ERROR))
+    {
+        LOGE("Process info reader exited, restarting it");
+        self->restart_reader();
+        return 0;
+    }
+
+    self->buffer.resize(PROCESS_RECORD_MAX);
+    ssize_t len;
+    while ((len = recv(fd, self->buffer.data(), self->buffer.size(), 0)) > 0)
+    {
+        process_info_t info;
+        if (self->in_flight.empty() ||
+            !decode_process_record(std::string_view(self->buffer.data(), len), info) ||
+            (info.pid != self->in_flight.front().pid))
+        {
+            LOGE("Unexpected reply from the process info reader");
+            self->restart_reader();
+            return 0;
+        }
+
+        self->in_flight.pop_front();
+        self->pending.erase(info.pid);
+        info.timestamp_ns = get_monotonic_ns();
+        self->cache[info.pid] = std::move(info);
+    }
+
+    self->send_requests();
+    self->arm_timeout();
+    return 0;
+}
+
+int process_info_cache_t::handle_timeout(void *data)
+{
+    auto self = (process_info_cache_t*)data;
+    if (self->in_flight.empty())
+    {
+        return 0;
+    }
+
+    auto request = self->in_flight.front();
+    if (get_monotonic_ns() - request.sent_ns < REQUEST_TIMEOUT_MS * 1000000ull)
+    {
+        self->arm_timeout();
+        return 0;
+    }
+
+    /* Not retried before the TTL is over */
+    LOGE("Reading /proc/", request.pid, " timed out");
+    self->in_flight.pop_front();
+    self->pending.erase(request.pid);
+    process_info_t info;
+    info.pid = request.pid;
+    info.timestamp_ns = get_monotonic_ns();
+    self->cache[request.pid] = std::move(info);
+
+    self->restart_reader();
+    return 0;
+}
+
+const process_info_t *process_info_cache_t::get(pid_t pid)
+{
+    if (!active || (pid <= 0))
+    {
+        return nullptr;
+    }
+
+    uint64_t ttl_ns = uint64_t(std::max(0, (int)ttl_opt)) * 1000000;
+    uint64_t now    = get_monotonic_ns();
+
+    auto it = cache.find(pid);
+    bool stale = (it == cache.end()) || (now - it->second.timestamp_ns > ttl_ns);
+    if (stale && !pending.count(pid))
+    {
+        if (cache.size() > 1024)
+        {
+            for (auto i = cache.begin(); i != cache.end();)
+            {
+                i = (now - i->second.timestamp_ns > EXPIRE_TTLS * ttl_ns) ? cache.erase(i) : std::next(i);
+            }
+
+            it = cache.find(pid);
+        }
+
+        pending.insert(pid);
+        queued.push_back(pid);
+        send_requests();
+    }
+
+    return it != cache.end() ? &it->second : nullptr;
+}
+
+wf::json_t process_info_cache_t::to_json(pid_t pid)
+{
+    auto info = get(pid);
+    if (!info)
+    {
+        return wf::json_t::null();
+    }
+
+    return info->to_json();
+}
+
+wf::json_t process_info_cache_t::cached_json(pid_t pid) const
+{
+    auto it = cache.find(pid);
+    if (!active || (it == cache.end()))
+    {
+        return wf::json_t::null();
+    }
+
+    return it->second.to_json();
+}
@@ -0,0 +1,113 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <wayland-server-core.h>
+#include <wayfire/option-wrapper.hpp>
+#include <wayfire/nonstd/json.hpp>
+
+#include "process-record.hpp"
+
+/* Process details read from /proc/<pid> */
+struct process_info_t : public process_record_t
+{
+    /* CLOCK_MONOTONIC time at which the data was received */
+    uint64_t timestamp_ns = 0;
+
+    wf::json_t to_json() const;
+};
+
+/*
+ * Cache of process_info_t per pid. /proc is only read by the
+ * wf-info-proc-reader helper process, whose replies are handled on the
+ * compositor event loop, so lookups never block the compositor. A lookup of
+ * a pid which is not cached or older than wf-info/process_info_ttl schedules
+ * a refresh and returns whatever is cached at the moment.
+ *
+ * A read of /proc can wait for as long as the target process holds its
+ * locks. A request which takes longer than REQUEST_TIMEOUT_MS is answered
+ * with invalid info and the helper is killed and restarted, so one stuck
+ * process does not hold up the others.
+ */
+class process_info_cache_t
+{
+    wf::option_wrapper_t<bool> enabled_opt{"wf-info/process_info"};
+    wf::option_wrapper_t<int> ttl_opt{"wf-info/process_info_ttl"};
+
+    static constexpr int REQUEST_TIMEOUT_MS = 500;
+    /* Requests written to the socket at once, the rest wait in queued */
+    static constexpr size_t MAX_IN_FLIGHT = 32;
+
+    bool active = false;
+    pid_t reader_pid = -1;
+    int reader_fd    = -1;
+    wl_event_source *reader_source = nullptr;
+    wl_event_source *timeout_timer = nullptr;
+
+    struct request_t
+    {
+        pid_t pid;
+        uint64_t sent_ns;
+    };
+
+    /* The helper answers in order, so the oldest request is first */
+    std::deque<request_t> in_flight;
+    std::deque<pid_t> queued;
+    std::unordered_set<pid_t> pending;
+    std::unordered_map<pid_t, process_info_t> cache;
+    std::string buffer;
+
+    void start();
+    void stop();
+    bool spawn_reader();
+    void kill_reader();
+    void restart_reader();
+    void send_requests();
+    void arm_timeout();
+    static int handle_reader(int fd, uint32_t mask, void *data);
+    static int handle_timeout(void *data);
+
+  public:
+    process_info_cache_t();
+    ~process_info_cache_t();
+
+    bool enabled() const
+    {
+        return active;
+    }
+
+    /* Cached info for pid or nullptr, refreshing it in the background if
+     * needed. */
+    const process_info_t *get(pid_t pid);
+    wf::json_t to_json(pid_t pid);
+
+    /* Cached info for pid or null, without scheduling a refresh. Used for
+     * bulk replies, which should not queue a /proc read per view. */
+    wf::json_t cached_json(pid_t pid) const;
+};
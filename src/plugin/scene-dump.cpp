@@ -0,0 +1,228 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <string>
+#include <cxxabi.h>
+#include <typeindex>
+#include <wayfire/core.hpp>
+#include <wayfire/view.hpp>
+#include <wayfire/output-layout.hpp>
+
+#include "scene-dump.hpp"
+#include "ipc-rules-common.hpp"
+
+scene_damage_recorder_t::scene_damage_recorder_t()
+{
+    /* Only connected while recording */
+    on_output_added = [=] (wf::output_added_signal *ev)
+    {
+        count_frames(ev->output);
+    };
+
+    on_output_pre_remove = [=] (wf::output_pre_remove_signal *ev)
+    {
+        auto it = frame_hooks.find(ev->output);
+        if (it != frame_hooks.end())
+        {
+            ev->output->render->rem_effect(it->second.get());
+            frame_hooks.erase(it);
+        }
+    };
+    wf::get_core().output_layout->connect(&on_output_pre_remove);
+}
+
+scene_damage_recorder_t::~scene_damage_recorder_t()
+{
+    clear();
+}
+
+/* Watch node and its subtree, keeping the counts of nodes already watched */
+void scene_damage_recorder_t::watch(wf::scene::node_t *node)
+{
+    auto& entry = nodes[node];
+    if (!entry || (entry->node.lock().get() != node))
+    {
+        entry = std::make_unique<node_damage_t>();
+        auto record = entry.get();
+        record->node = node->shared_from_this();
+        record->on_damage = [=] (wf::scene::node_damage_signal *ev)
+        {
+            record->count++;
+            for (auto& box : ev->region)
+            {
+                record->area += uint64_t(box.x2 - box.x1) * uint64_t(box.y2 - box.y1);
+            }
+        };
+        record->on_children_changed = [=] (wf::scene::node_regen_instances_signal*)
+        {
+            watch(node);
+        };
+        node->connect(&record->on_damage);
+        node->connect(&record->on_children_changed);
+    }
+
+    for (auto& child : node->get_children())
+    {
+        watch(child.get());
+    }
+}
+
+void scene_damage_recorder_t::count_frames(wf::output_t *output)
+{
+    output_frames[output] = 0;
+    auto hook = std::make_unique<wf::effect_hook_t>([=] ()
+    {
+        frames = std::max(frames, ++output_frames[output]);
+        if (frames >= target_frames)
+        {
+            /* Effect hooks cannot be removed while they run */
+            idle_stop.run_once([=] () { stop_recording(); });
+        }
+    });
+    output->render->add_effect(hook.get(), wf::OUTPUT_EFFECT_POST);
+    frame_hooks[output] = std::move(hook);
+}
+
+void scene_damage_recorder_t::start(int num_frames)
+{
+    clear();
+    target_frames = std::max(num_frames, 1);
+    active = true;
+    watch(wf::get_core().scene().get());
+    wf::get_core().output_layout->connect(&on_output_added);
+    for (auto& o : wf::get_core().output_layout->get_outputs())
+    {
+        count_frames(o);
+    }
+}
+
+void scene_damage_recorder_t::stop_recording()
+{
+    for (auto& [o, hook] : frame_hooks)
+    {
+        o->render->rem_effect(hook.get());
+    }
+
+    frame_hooks.clear();
+    output_frames.clear();
+    on_output_added.disconnect();
+    for (auto& [node, entry] : nodes)
+    {
+        entry->on_damage.disconnect();
+        entry->on_children_changed.disconnect();
+    }
+
+    active = false;
+}
+
+void scene_damage_recorder_t::clear()
+{
+    stop_recording();
+    nodes.clear();
+    frames = 0;
+}
+
+const scene_damage_recorder_t::node_damage_t *scene_damage_recorder_t::get(
+    wf::scene::node_t *node) const
+{
+    auto it = nodes.find(node);
+    if ((it == nodes.end()) || (it->second->node.lock().get() != node))
+    {
+        return nullptr;
+    }
+
+    return it->second.get();
+}
+
+/* Demangled class name, computed once per type */
+static const std::string& get_node_type(wf::scene::node_t *node)
+{
+    static std::unordered_map<std::type_index, std::string> names;
+    auto& type = typeid(*node);
+    auto it    = names.find(type);
+    if (it != names.end())
+    {
+        return it->second;
+    }
+
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+    std::string name = (status == 0) && demangled ? demangled : type.name();
+    free(demangled);
+    return names.emplace(type, name).first->second;
+}
+
+wf::json_t scene_to_json(wf::scene::node_t *node, const scene_damage_recorder_t& damage)
+{
+    auto bbox = node->get_bounding_box();
+
+    wf::json_t description;
+    description["type"] = get_node_type(node);
+    description["description"] = node->stringify();
+    description["enabled"]   = node->is_enabled();
+    description["structure"] = node->is_structure_node();
+    description["bbox"] = wf::ipc::geometry_to_json(bbox);
+
+    /* Opaque regions are only known for surfaces. They are surface-local,
+     * offset by the bbox origin to be in the same coordinates as bbox. */
+    description["opaque"] = wf::json_t::array();
+    auto surface_node = dynamic_cast<wf::scene::wlr_surface_node_t*>(node);
+    if (auto surface = surface_node ? surface_node->get_surface() : nullptr)
+    {
+        int count = 0;
+        auto rects = pixman_region32_rectangles(&surface->opaque_region, &count);
+        for (int i = 0; i < count; i++)
+        {
+            description["opaque"].append(wf::ipc::geometry_to_json({bbox.x + rects[i].x1,
+                bbox.y + rects[i].y1, rects[i].x2 - rects[i].x1, rects[i].y2 - rects[i].y1}));
+        }
+    }
+
+    if (auto view = wf::node_to_view(node->shared_from_this()))
+    {
+        description["view-id"] = (int)view->get_id();
+    }
+
+    if (damage.recorded())
+    {
+        wf::json_t record_json = wf::json_t::null();
+        if (auto record = damage.get(node))
+        {
+            record_json = wf::json_t();
+            record_json["count"] = (int64_t)record->count;
+            record_json["area"]  = record->area;
+        }
+
+        description["damage"] = record_json;
+    }
+
+    description["children"] = wf::json_t::array();
+    for (auto& child : node->get_children())
+    {
+        description["children"].append(scene_to_json(child.get(), damage));
+    }
+
+    return description;
+}
@@ -0,0 +1,101 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <map>
+#include <unordered_map>
+#include <wayfire/scene.hpp>
+#include <wayfire/output.hpp>
+#include <wayfire/render-manager.hpp>
+#include <wayfire/signal-definitions.hpp>
+#include <wayfire/util.hpp>
+#include <wayfire/nonstd/json.hpp>
+
+/*
+ * Damage reported by each scene node during the next N frames, recorded on
+ * request. Only damage originating at a node is counted for it, damage of
+ * its children is counted for the children. Nodes added to the scene while
+ * recording are watched from then on; nodes added afterwards have no record.
+ */
+class scene_damage_recorder_t
+{
+  public:
+    struct node_damage_t
+    {
+        /* Addresses may be reused once a node is gone */
+        std::weak_ptr<wf::scene::node_t> node;
+        uint32_t count = 0;
+        uint64_t area  = 0;
+        wf::signal::connection_t<wf::scene::node_damage_signal> on_damage;
+        /* Emitted on the node whose children changed */
+        wf::signal::connection_t<wf::scene::node_regen_instances_signal> on_children_changed;
+    };
+
+  private:
+    std::unordered_map<wf::scene::node_t*, std::unique_ptr<node_damage_t>> nodes;
+    std::map<wf::output_t*, std::unique_ptr<wf::effect_hook_t>> frame_hooks;
+    std::map<wf::output_t*, int> output_frames;
+    wf::signal::connection_t<wf::output_added_signal> on_output_added;
+    wf::signal::connection_t<wf::output_pre_remove_signal> on_output_pre_remove;
+    wf::wl_idle_call idle_stop;
+    int target_frames = 0;
+    bool active = false;
+
+    void watch(wf::scene::node_t *node);
+    void count_frames(wf::output_t *output);
+    void stop_recording();
+
+  public:
+    /* Most frames rendered by any output since recording started */
+    int frames = 0;
+
+    scene_damage_recorder_t();
+    ~scene_damage_recorder_t();
+
+    /* Forget previous results and record the next num_frames frames */
+    void start(int num_frames);
+    void clear();
+    bool recording() const
+    {
+        return active;
+    }
+
+    /* Whether there are results, from a running or a finished recording */
+    bool recorded() const
+    {
+        return !nodes.empty();
+    }
+
+    const node_damage_t *get(wf::scene::node_t *node) const;
+};
+
+/*
+ * Description of node and its subtree, built in one traversal: type,
+ * description, enabled state, bounding box, opaque region of surfaces, the
+ * view it is the root node of and, once damage has been recorded, its
+ * damage, which is null for nodes that were not watched.
+ */
+wf::json_t scene_to_json(wf::scene::node_t *node, const scene_damage_recorder_t& damage);
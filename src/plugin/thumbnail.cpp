@@ -0,0 +1,238 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <algorithm>
+#include <drm_fourcc.h>
+#include <wayfire/core.hpp>
+#include <wayfire/scene.hpp>
+#include <wayfire/output.hpp>
+#include <wayfire/render.hpp>
+#include <wayfire/scene-render.hpp>
+#include <wayfire/util/log.hpp>
+#include <wayfire/nonstd/wlroots-full.hpp>
+
+#include "thumbnail.hpp"
+#include "shm-util.hpp"
+#include "downscale.hpp"
+
+view_thumbnail_t::view_thumbnail_t(wayfire_view view) : view(view)
+{}
+
+view_thumbnail_t::~view_thumbnail_t()
+{
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+void view_thumbnail_t::watch(wf::scene::node_t *node)
+{
+    auto damage = std::make_unique<wf::signal::connection_t<wf::scene::node_damage_signal>>();
+    *damage = [=] (wf::scene::node_damage_signal*)
+    {
+        damaged = true;
+    };
+    node->connect(damage.get());
+    on_damage.push_back(std::move(damage));
+
+    auto children = std::make_unique<wf::signal::connection_t<wf::scene::node_regen_instances_signal>>();
+    *children = [=] (wf::scene::node_regen_instances_signal*)
+    {
+        nodes_changed = true;
+        damaged = true;
+    };
+    node->connect(children.get());
+    on_children_changed.push_back(std::move(children));
+
+    for (auto& child : node->get_children())
+    {
+        watch(child.get());
+    }
+}
+
+void view_thumbnail_t::watch_nodes()
+{
+    on_damage.clear();
+    on_children_changed.clear();
+    watch(view->get_root_node().get());
+    nodes_changed = false;
+}
+
+static bool read_texture(wlr_texture *texture, uint8_t *data)
+{
+    wlr_texture_read_pixels_options options{};
+    options.data   = data;
+    options.format = DRM_FORMAT_ARGB8888;
+    options.stride = texture->width * 4;
+    return wlr_texture_read_pixels(texture, &options);
+}
+
+bool view_thumbnail_t::render_scaled(info_size_t max_size)
+{
+    auto root   = view->get_surface_root_node();
+    auto bbox   = root->get_bounding_box();
+    auto output = view->get_output();
+    float scale = output ? output->handle->scale : 1.0f;
+
+    size = fit_size({int32_t(bbox.width * scale), int32_t(bbox.height * scale)}, max_size);
+    if ((size.width <= 0) || (size.height <= 0))
+    {
+        return false;
+    }
+
+    /* The whole bounding box is projected onto the thumbnail sized buffer */
+    wf::auxilliary_buffer_t buffer;
+    buffer.allocate({size.width, size.height});
+    wf::render_target_t target{buffer};
+    target.geometry = bbox;
+    target.scale    = float(size.width) / bbox.width;
+
+    std::vector<wf::scene::render_instance_uptr> instances;
+    root->gen_render_instances(instances, [] (auto) {}, output);
+
+    wf::render_pass_params_t params;
+    params.instances = &instances;
+    params.damage    = bbox;
+    params.target    = target;
+    params.background_color = {0, 0, 0, 0};
+    params.flags = wf::RPASS_CLEAR_BACKGROUND;
+    wf::render_pass_t::run(params);
+
+    auto texture = buffer.get_texture();
+    pixels.resize(size_t(size.width) * size.height * 4);
+    return texture && (int(texture->width) == size.width) &&
+           (int(texture->height) == size.height) && read_texture(texture, pixels.data());
+}
+
+bool view_thumbnail_t::render_downscaled(info_size_t max_size)
+{
+    /* Full size buffers, only needed until the downscale is done */
+    wf::auxilliary_buffer_t snapshot;
+    std::vector<uint8_t> readback;
+
+    view->take_snapshot(snapshot);
+    auto texture = snapshot.get_texture();
+    if (!texture)
+    {
+        return false;
+    }
+
+    int width  = texture->width;
+    int height = texture->height;
+    size = fit_size({width, height}, max_size);
+    if ((size.width <= 0) || (size.height <= 0))
+    {
+        return false;
+    }
+
+    readback.resize(size_t(width) * height * 4);
+    bool read = read_texture(texture, readback.data());
+    snapshot.free();
+    if (!read)
+    {
+        return false;
+    }
+
+    pixels.resize(size_t(size.width) * size.height * 4);
+    downscale_box(readback.data(), width, height, width * 4,
+        pixels.data(), size.width, size.height, size.width * 4);
+    return true;
+}
+
+bool view_thumbnail_t::update(info_size_t max_size)
+{
+    if (nodes_changed)
+    {
+        watch_nodes();
+    }
+
+    if (!damaged && (max_size.width == this->max_size.width) &&
+        (max_size.height == this->max_size.height))
+    {
+        return true;
+    }
+
+    if (!view->is_mapped())
+    {
+        return false;
+    }
+
+    bool rendered = wlr_renderer_is_pixman(wf::get_core().renderer) ?
+        render_downscaled(max_size) : render_scaled(max_size);
+    if (!rendered)
+    {
+        LOGE("Failed to render thumbnail of view ", view);
+        return false;
+    }
+
+    if (fd >= 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+
+    this->max_size = max_size;
+    damaged = false;
+    return true;
+}
+
+int view_thumbnail_t::get_fd()
+{
+    if (fd < 0)
+    {
+        fd = create_sealed_memfd("wf-info-thumbnail", pixels.data(), pixels.size());
+    }
+
+    return fd;
+}
+
+thumbnail_cache_t::thumbnail_cache_t()
+{
+    on_view_unmapped = [=] (wf::view_unmapped_signal *ev)
+    {
+        thumbnails.erase(ev->view->get_id());
+    };
+    wf::get_core().connect(&on_view_unmapped);
+}
+
+view_thumbnail_t *thumbnail_cache_t::get(wayfire_view view, info_size_t max_size)
+{
+    if (!view || !view->is_mapped())
+    {
+        return nullptr;
+    }
+
+    max_size.width  = std::clamp(max_size.width, MIN_SIZE, MAX_SIZE);
+    max_size.height = std::clamp(max_size.height, MIN_SIZE, MAX_SIZE);
+
+    auto& thumbnail = thumbnails[view->get_id()];
+    if (!thumbnail)
+    {
+        thumbnail = std::make_unique<view_thumbnail_t>(view);
+    }
+
+    return thumbnail->update(max_size) ? thumbnail.get() : nullptr;
+}
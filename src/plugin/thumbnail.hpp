@@ -0,0 +1,96 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <wayfire/view.hpp>
+#include <wayfire/scene.hpp>
+#include <wayfire/signal-definitions.hpp>
+
+#include "view-fields.hpp"
+
+/*
+ * Downscaled copy of a view's contents. The view is rendered scaled into a
+ * buffer of the thumbnail size and only that is read back. The pixman
+ * renderer only samples the nearest pixel when scaling, so with it the view
+ * is read back at full size and box filtered on the CPU instead. The result
+ * stays valid until the view is damaged.
+ */
+class view_thumbnail_t
+{
+    wayfire_view view;
+    /* Damage is reported on the node it originates at and a change of the
+     * children is reported on the node whose children changed, so every node
+     * of the view is watched. The set is rebuilt on the next update after a
+     * change, not from the signal which reports it. */
+    std::vector<std::unique_ptr<wf::signal::connection_t<wf::scene::node_damage_signal>>> on_damage;
+    std::vector<std::unique_ptr<wf::signal::connection_t<wf::scene::node_regen_instances_signal>>>
+    on_children_changed;
+
+    bool damaged = true;
+    bool nodes_changed = true;
+    info_size_t max_size{0, 0};
+    int fd = -1;
+
+    void watch(wf::scene::node_t *node);
+    void watch_nodes();
+    bool render_scaled(info_size_t max_size);
+    bool render_downscaled(info_size_t max_size);
+
+  public:
+    /* DRM_FORMAT_ARGB8888, premultiplied alpha */
+    std::vector<uint8_t> pixels;
+    info_size_t size{0, 0};
+
+    view_thumbnail_t(wayfire_view view);
+    ~view_thumbnail_t();
+
+    /* Re-render if the view was damaged or a different size is asked for.
+     * Returns false if the view cannot be rendered. */
+    bool update(info_size_t max_size);
+
+    /* Sealed memfd with the pixels, owned by the thumbnail */
+    int get_fd();
+};
+
+/* Thumbnails of mapped views, dropped when a view is unmapped */
+class thumbnail_cache_t
+{
+    std::unordered_map<uint32_t, std::unique_ptr<view_thumbnail_t>> thumbnails;
+    wf::signal::connection_t<wf::view_unmapped_signal> on_view_unmapped;
+
+  public:
+    /* Requested sizes are clamped to this range */
+    static constexpr int MIN_SIZE = 16;
+    static constexpr int MAX_SIZE = 1024;
+
+    thumbnail_cache_t();
+
+    /* Up to date thumbnail of view or nullptr if it cannot be rendered */
+    view_thumbnail_t *get(wayfire_view view, info_size_t max_size);
+};
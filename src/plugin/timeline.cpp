@@ -0,0 +1,186 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <algorithm>
+#include <wayfire/core.hpp>
+#include <wayfire/output.hpp>
+#include <wayfire/output-layout.hpp>
+#include <wayfire/toplevel-view.hpp>
+
+#include "timeline.hpp"
+#include "shm-util.hpp"
+
+event_timeline_t::event_timeline_t()
+{
+    on_view_mapped = [=] (wf::view_mapped_signal *ev)
+    {
+        auto bbox = ev->view->get_bounding_box();
+        record(TIMELINE_EVENT_MAP, ev->view->get_id(), bbox.x, bbox.y, bbox.width, bbox.height);
+        connect_view(ev->view);
+    };
+
+    on_view_unmapped = [=] (wf::view_unmapped_signal *ev)
+    {
+        record(TIMELINE_EVENT_UNMAP, ev->view->get_id());
+        disconnect_view(ev->view);
+    };
+
+    on_keyboard_focus_changed = [=] (wf::keyboard_focus_changed_signal *ev)
+    {
+        auto view = wf::node_to_view(ev->new_focus);
+        record(TIMELINE_EVENT_FOCUS, view ? view->get_id() : 0);
+    };
+
+    on_view_geometry_changed = [=] (wf::view_geometry_changed_signal *ev)
+    {
+        auto toplevel = wf::toplevel_cast(ev->view);
+        auto g = toplevel ? toplevel->get_geometry() : ev->view->get_bounding_box();
+        record(TIMELINE_EVENT_GEOMETRY, ev->view->get_id(), g.x, g.y, g.width, g.height);
+    };
+
+    on_view_title_changed = [=] (wf::view_title_changed_signal *ev)
+    {
+        record(TIMELINE_EVENT_TITLE, ev->view->get_id(), ev->view->get_title().size());
+    };
+
+    on_view_set_output = [=] (wf::view_set_output_signal *ev)
+    {
+        auto output = ev->view->get_output();
+        record(TIMELINE_EVENT_OUTPUT, ev->view->get_id(),
+            output ? (int32_t)output->get_id() : -1,
+            ev->output ? (int32_t)ev->output->get_id() : -1);
+    };
+
+    on_workspace_changed = [=] (wf::workspace_changed_signal *ev)
+    {
+        record(TIMELINE_EVENT_WORKSPACE, 0, ev->output->get_id(),
+            ev->new_viewport.x, ev->new_viewport.y);
+    };
+
+    on_output_added = [=] (wf::output_added_signal *ev)
+    {
+        ev->output->connect(&on_workspace_changed);
+    };
+
+    timeline_size.set_callback([=] ()
+    {
+        resize(timeline_size);
+    });
+    resize(timeline_size);
+}
+
+event_timeline_t::~event_timeline_t()
+{
+    disconnect_signals();
+}
+
+void event_timeline_t::resize(int size)
+{
+    disconnect_signals();
+    ring.resize(std::max(size, 0));
+    if (enabled())
+    {
+        connect_signals();
+    }
+}
+
+void event_timeline_t::connect_signals()
+{
+    wf::get_core().connect(&on_view_mapped);
+    wf::get_core().connect(&on_view_unmapped);
+    wf::get_core().connect(&on_keyboard_focus_changed);
+    wf::get_core().output_layout->connect(&on_output_added);
+    for (auto& o : wf::get_core().output_layout->get_outputs())
+    {
+        o->connect(&on_workspace_changed);
+    }
+
+    for (auto& view : wf::get_core().get_all_views())
+    {
+        if (view->is_mapped())
+        {
+            connect_view(view);
+        }
+    }
+}
+
+void event_timeline_t::disconnect_signals()
+{
+    on_view_mapped.disconnect();
+    on_view_unmapped.disconnect();
+    on_keyboard_focus_changed.disconnect();
+    on_view_geometry_changed.disconnect();
+    on_view_title_changed.disconnect();
+    on_view_set_output.disconnect();
+    on_workspace_changed.disconnect();
+    on_output_added.disconnect();
+}
+
+void event_timeline_t::connect_view(wayfire_view view)
+{
+    view->connect(&on_view_geometry_changed);
+    view->connect(&on_view_title_changed);
+    view->connect(&on_view_set_output);
+}
+
+void event_timeline_t::disconnect_view(wayfire_view view)
+{
+    view->disconnect(&on_view_geometry_changed);
+    view->disconnect(&on_view_title_changed);
+    view->disconnect(&on_view_set_output);
+}
+
+wf::json_t event_timeline_t::to_json() const
+{
+    wf::json_t response = wf::json_t::array();
+    for (auto& r : snapshot())
+    {
+        wf::json_t event;
+        event["timestamp-ns"] = r.timestamp_ns;
+        event["event"]   = timeline_event_name(r.type);
+        event["view-id"] = r.view_id;
+        auto names = timeline_data_names(r.type);
+        for (int i = 0; i < 4; i++)
+        {
+            if (names[i])
+            {
+                event[names[i]] = r.data[i];
+            }
+        }
+
+        response.append(event);
+    }
+
+    return response;
+}
+
+int event_timeline_t::to_memfd(uint32_t& count) const
+{
+    auto events = snapshot();
+    count = events.size();
+
+    return create_sealed_memfd("wf-info-timeline", events.data(),
+        events.size() * sizeof(timeline_record_t));
+}
@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <wayfire/view.hpp>
+#include <wayfire/option-wrapper.hpp>
+#include <wayfire/signal-definitions.hpp>
+#include <wayfire/nonstd/json.hpp>
+
+#include "timeline-record.hpp"
+
+/*
+ * Records the most recent desktop events into a timeline_ring_t. The
+ * compositor thread is the only writer. When wf-info/timeline_size is 0 no
+ * signals are connected and recording costs nothing.
+ */
+class event_timeline_t
+{
+    wf::option_wrapper_t<int> timeline_size{"wf-info/timeline_size"};
+    timeline_ring_t ring;
+
+    wf::signal::connection_t<wf::view_mapped_signal> on_view_mapped;
+    wf::signal::connection_t<wf::view_unmapped_signal> on_view_unmapped;
+    wf::signal::connection_t<wf::keyboard_focus_changed_signal> on_keyboard_focus_changed;
+    wf::signal::connection_t<wf::view_geometry_changed_signal> on_view_geometry_changed;
+    wf::signal::connection_t<wf::view_title_changed_signal> on_view_title_changed;
+    wf::signal::connection_t<wf::view_set_output_signal> on_view_set_output;
+    wf::signal::connection_t<wf::workspace_changed_signal> on_workspace_changed;
+    wf::signal::connection_t<wf::output_added_signal> on_output_added;
+
+    void resize(int size);
+    void connect_signals();
+    void disconnect_signals();
+    void connect_view(wayfire_view view);
+    void disconnect_view(wayfire_view view);
+
+  public:
+    event_timeline_t();
+    ~event_timeline_t();
+
+    bool enabled() const
+    {
+        return ring.capacity() > 0;
+    }
+
+    void record(uint32_t type, uint32_t view_id,
+        int32_t a = 0, int32_t b = 0, int32_t c = 0, int32_t d = 0)
+    {
+        ring.record(type, view_id, a, b, c, d);
+    }
+
+    /* Recorded events, oldest first */
+    std::vector<timeline_record_t> snapshot() const
+    {
+        return ring.snapshot();
+    }
+
+    void clear()
+    {
+        ring.clear();
+    }
+
+    wf::json_t to_json() const;
+    /* Sealed memfd containing the snapshot, -1 on failure */
+    int to_memfd(uint32_t& count) const;
+};
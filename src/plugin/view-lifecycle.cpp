@@ -0,0 +1,276 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <algorithm>
+#include <wayfire/core.hpp>
+#include <wayfire/nonstd/wlroots-full.hpp>
+
+#include "view-lifecycle.hpp"
+#include "timing.hpp"
+
+/* Pending creation timestamps older than this are from surfaces which are
+ * still alive but were never mapped. */
+static constexpr uint64_t PENDING_EXPIRE_NS = 60ull * 1000000000ull;
+
+static wf::json_t latency_to_json(uint64_t from_ns, uint64_t to_ns)
+{
+    if (!from_ns || !to_ns)
+    {
+        return wf::json_t::null();
+    }
+
+    return (to_ns - from_ns) / 1000;
+}
+
+wf::json_t view_lifecycle_t::to_json() const
+{
+    wf::json_t response;
+    response["create-to-map-us"] = latency_to_json(created_ns, mapped_ns);
+    response["map-to-first-commit-us"] = latency_to_json(mapped_ns, first_commit_ns);
+    response["map-to-first-focus-us"]  = latency_to_json(mapped_ns, first_focus_ns);
+    return response;
+}
+
+void latency_samples_t::add(uint64_t us)
+{
+    if (samples.size() < MAX_SAMPLES)
+    {
+        samples.push_back(us);
+    } else
+    {
+        samples[next] = us;
+    }
+
+    next = (next + 1) % MAX_SAMPLES;
+    total++;
+}
+
+wf::json_t latency_samples_t::to_json() const
+{
+    wf::json_t response;
+    response["count"] = total;
+    if (samples.empty())
+    {
+        return response;
+    }
+
+    auto sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    auto at = [&] (double p)
+    {
+        return sorted[std::min(sorted.size() - 1, size_t(p * sorted.size()))];
+    };
+    response["p50-us"] = at(0.50);
+    response["p90-us"] = at(0.90);
+    response["p99-us"] = at(0.99);
+    response["max-us"] = sorted.back();
+    return response;
+}
+
+wf::json_t app_launch_stats_t::to_json() const
+{
+    wf::json_t response;
+    response["create-to-map"] = create_to_map.to_json();
+    response["map-to-first-commit"] = map_to_first_commit.to_json();
+    response["map-to-first-focus"]  = map_to_first_focus.to_json();
+    return response;
+}
+
+view_lifecycle_tracker_t::view_lifecycle_tracker_t()
+{
+    on_new_xdg_surface = [=] (wf::new_xdg_surface_signal *ev)
+    {
+        uint64_t now = get_monotonic_ns();
+        expire_pending(now);
+        auto surface  = ev->surface->surface;
+        auto& pending = pending_created[surface];
+        pending = std::make_unique<pending_surface_t>();
+        pending->created_ns = now;
+
+        /* This destroys the listener from its own callback, which is fine
+         * as long as nothing of it is used afterwards */
+        pending->on_destroy.set_callback([this, surface] (void*)
+        {
+            pending_created.erase(surface);
+        });
+        pending->on_destroy.connect(&surface->events.destroy);
+    };
+
+    on_view_mapped = [=] (wf::view_mapped_signal *ev)
+    {
+        auto view = ev->view;
+        auto lifecycle = view->get_data_safe<view_lifecycle_t>();
+        if (lifecycle->mapped_ns)
+        {
+            /* Only the first map is interesting for start-up latency */
+            return;
+        }
+
+        lifecycle->mapped_ns = get_monotonic_ns();
+
+        auto surface = view->get_wlr_surface();
+        if (!surface)
+        {
+            return;
+        }
+
+        auto it = pending_created.find(surface);
+        if (it != pending_created.end())
+        {
+            lifecycle->created_ns = it->second->created_ns;
+            pending_created.erase(it);
+        }
+
+        bool sample = view->role == wf::VIEW_ROLE_TOPLEVEL;
+        std::string app_id = view->get_app_id();
+        if (sample && lifecycle->created_ns)
+        {
+            get_app_stats(app_id).create_to_map.add(
+                (lifecycle->mapped_ns - lifecycle->created_ns) / 1000);
+        }
+
+        /* The commit which mapped the view is the one being handled now */
+        lifecycle->map_seq = surface->current.seq;
+        lifecycle->on_commit.set_callback([=] (void*)
+        {
+            if (surface->current.seq == lifecycle->map_seq)
+            {
+                return;
+            }
+
+            lifecycle->first_commit_ns = get_monotonic_ns();
+            if (sample)
+            {
+                get_app_stats(app_id).map_to_first_commit.add(
+                    (lifecycle->first_commit_ns - lifecycle->mapped_ns) / 1000);
+            }
+
+            lifecycle->on_commit.disconnect();
+        });
+        lifecycle->on_commit.connect(&surface->events.commit);
+    };
+
+    on_view_unmapped = [=] (wf::view_unmapped_signal *ev)
+    {
+        if (auto lifecycle = ev->view->get_data<view_lifecycle_t>())
+        {
+            lifecycle->on_commit.disconnect();
+        }
+    };
+
+    on_keyboard_focus_changed = [=] (wf::keyboard_focus_changed_signal *ev)
+    {
+        auto view = wf::node_to_view(ev->new_focus);
+        if (!view)
+        {
+            return;
+        }
+
+        auto lifecycle = view->get_data<view_lifecycle_t>();
+        if (!lifecycle || !lifecycle->mapped_ns || lifecycle->first_focus_ns)
+        {
+            return;
+        }
+
+        lifecycle->first_focus_ns = get_monotonic_ns();
+        if (view->role == wf::VIEW_ROLE_TOPLEVEL)
+        {
+            get_app_stats(view->get_app_id()).map_to_first_focus.add(
+                (lifecycle->first_focus_ns - lifecycle->mapped_ns) / 1000);
+        }
+    };
+
+    wf::get_core().connect(&on_new_xdg_surface);
+    wf::get_core().connect(&on_view_mapped);
+    wf::get_core().connect(&on_view_unmapped);
+    wf::get_core().connect(&on_keyboard_focus_changed);
+}
+
+view_lifecycle_tracker_t::~view_lifecycle_tracker_t()
+{
+    /* The commit listeners reference this tracker */
+    for (auto& view : wf::get_core().get_all_views())
+    {
+        view->erase_data<view_lifecycle_t>();
+    }
+}
+
+void view_lifecycle_tracker_t::expire_pending(uint64_t now)
+{
+    for (auto it = pending_created.begin(); it != pending_created.end();)
+    {
+        if (now - it->second->created_ns > PENDING_EXPIRE_NS)
+        {
+            it = pending_created.erase(it);
+        } else
+        {
+            ++it;
+        }
+    }
+}
+
+app_launch_stats_t& view_lifecycle_tracker_t::get_app_stats(const std::string& app_id)
+{
+    auto it = app_stats.find(app_id);
+    if (it == app_stats.end())
+    {
+        if (app_stats.size() >= MAX_APPS)
+        {
+            app_stats.erase(std::min_element(app_stats.begin(), app_stats.end(),
+                [] (const auto& a, const auto& b)
+            {
+                return a.second.last_sample_ns < b.second.last_sample_ns;
+            }));
+        }
+
+        it = app_stats.emplace(app_id, app_launch_stats_t{}).first;
+    }
+
+    it->second.last_sample_ns = get_monotonic_ns();
+    return it->second;
+}
+
+wf::json_t view_lifecycle_tracker_t::app_stats_to_json(std::string app_id) const
+{
+    wf::json_t response = wf::json_t::array();
+    for (auto& [id, stats] : app_stats)
+    {
+        if (!app_id.empty() && (id != app_id))
+        {
+            continue;
+        }
+
+        auto entry = stats.to_json();
+        entry["app-id"] = id;
+        response.append(entry);
+    }
+
+    return response;
+}
+
+void view_lifecycle_tracker_t::reset()
+{
+    app_stats.clear();
+}
@@ -0,0 +1,115 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <wayfire/util.hpp>
+#include <wayfire/object.hpp>
+#include <wayfire/view.hpp>
+#include <wayfire/signal-definitions.hpp>
+#include <wayfire/nonstd/json.hpp>
+
+/*
+ * Timestamps (CLOCK_MONOTONIC, ns) of the lifecycle of a single view, stored
+ * as custom data on the view. 0 means the event has not happened yet or was
+ * not observed, e.g. the view was created before the plugin was loaded.
+ *
+ * The view is mapped by the commit of its first buffer, so mapped_ns is the
+ * time of that commit. first_commit_ns is the next commit of the surface,
+ * i.e. the first frame the client drew after its initial buffer was shown.
+ */
+class view_lifecycle_t : public wf::custom_data_t
+{
+  public:
+    uint64_t created_ns     = 0;
+    uint64_t mapped_ns      = 0;
+    uint64_t first_commit_ns = 0;
+    uint64_t first_focus_ns = 0;
+
+    /* Surface commit sequence number at map time, used to skip the commit
+     * that mapped the view. */
+    uint32_t map_seq = 0;
+    wf::wl_listener_wrapper on_commit;
+
+    wf::json_t to_json() const;
+};
+
+/* Bounded set of the most recent latency samples, in microseconds. */
+struct latency_samples_t
+{
+    static constexpr size_t MAX_SAMPLES = 128;
+
+    std::vector<uint64_t> samples;
+    size_t next    = 0;
+    uint64_t total = 0;
+
+    void add(uint64_t us);
+    wf::json_t to_json() const;
+};
+
+struct app_launch_stats_t
+{
+    latency_samples_t create_to_map;
+    latency_samples_t map_to_first_commit;
+    latency_samples_t map_to_first_focus;
+    /* When a sample was last added, to evict idle apps */
+    uint64_t last_sample_ns = 0;
+
+    wf::json_t to_json() const;
+};
+
+class view_lifecycle_tracker_t
+{
+    struct pending_surface_t
+    {
+        uint64_t created_ns = 0;
+        wf::wl_listener_wrapper on_destroy;
+    };
+
+    /* Apps with launch stats, the least recently sampled is evicted first */
+    static constexpr size_t MAX_APPS = 256;
+
+    /* Creation time of surfaces which have not been mapped yet */
+    std::unordered_map<wlr_surface*, std::unique_ptr<pending_surface_t>> pending_created;
+    std::map<std::string, app_launch_stats_t> app_stats;
+
+    wf::signal::connection_t<wf::new_xdg_surface_signal> on_new_xdg_surface;
+    wf::signal::connection_t<wf::view_mapped_signal> on_view_mapped;
+    wf::signal::connection_t<wf::view_unmapped_signal> on_view_unmapped;
+    wf::signal::connection_t<wf::keyboard_focus_changed_signal> on_keyboard_focus_changed;
+
+    void expire_pending(uint64_t now);
+    app_launch_stats_t& get_app_stats(const std::string& app_id);
+
+  public:
+    view_lifecycle_tracker_t();
+    ~view_lifecycle_tracker_t();
+
+    wf::json_t app_stats_to_json(std::string app_id) const;
+    void reset();
+};
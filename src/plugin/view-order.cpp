@@ -0,0 +1,236 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <algorithm>
+#include <wayfire/core.hpp>
+#include <wayfire/scene.hpp>
+#include <wayfire/view-helpers.hpp>
+
+#include "view-order.hpp"
+
+mru_entry_t::~mru_entry_t()
+{
+    if (list)
+    {
+        list->unlink(this);
+    }
+}
+
+focus_mru_t::focus_mru_t()
+{
+    /* Seed the list once from the focus timestamps */
+    std::vector<wayfire_view> views;
+    for (auto& view : wf::get_core().get_all_views())
+    {
+        if (view->is_mapped() && (view->role == wf::VIEW_ROLE_TOPLEVEL))
+        {
+            views.push_back(view);
+        }
+    }
+
+    std::sort(views.begin(), views.end(), [] (wayfire_view a, wayfire_view b)
+    {
+        return wf::get_focus_timestamp(a) > wf::get_focus_timestamp(b);
+    });
+    for (auto& view : views)
+    {
+        link_back(get_entry(view));
+    }
+
+    /* Newly mapped views go to the back until they are focused */
+    on_view_mapped = [=] (wf::view_mapped_signal *ev)
+    {
+        if (ev->view->role == wf::VIEW_ROLE_TOPLEVEL)
+        {
+            auto entry = get_entry(ev->view);
+            if (!entry->list)
+            {
+                link_back(entry);
+            }
+        }
+    };
+
+    on_view_unmapped = [=] (wf::view_unmapped_signal *ev)
+    {
+        ev->view->erase_data<mru_entry_t>();
+    };
+
+    on_keyboard_focus_changed = [=] (wf::keyboard_focus_changed_signal *ev)
+    {
+        auto view = wf::node_to_view(ev->new_focus);
+        if (!view || !view->is_mapped() || (view->role != wf::VIEW_ROLE_TOPLEVEL))
+        {
+            return;
+        }
+
+        auto entry = get_entry(view);
+        if (entry == head)
+        {
+            return;
+        }
+
+        unlink(entry);
+        link_front(entry);
+    };
+
+    wf::get_core().connect(&on_view_mapped);
+    wf::get_core().connect(&on_view_unmapped);
+    wf::get_core().connect(&on_keyboard_focus_changed);
+}
+
+focus_mru_t::~focus_mru_t()
+{
+    while (head)
+    {
+        head->view->erase_data<mru_entry_t>();
+    }
+}
+
+mru_entry_t *focus_mru_t::get_entry(wayfire_view view)
+{
+    auto entry = view->get_data_safe<mru_entry_t>();
+    entry->view = view;
+    return entry;
+}
+
+void focus_mru_t::link_front(mru_entry_t *entry)
+{
+    entry->list = this;
+    entry->prev = nullptr;
+    entry->next = head;
+    if (head)
+    {
+        head->prev = entry;
+    } else
+    {
+        tail = entry;
+    }
+
+    head = entry;
+}
+
+void focus_mru_t::link_back(mru_entry_t *entry)
+{
+    entry->list = this;
+    entry->next = nullptr;
+    entry->prev = tail;
+    if (tail)
+    {
+        tail->next = entry;
+    } else
+    {
+        head = entry;
+    }
+
+    tail = entry;
+}
+
+void focus_mru_t::unlink(mru_entry_t *entry)
+{
+    if (entry->list != this)
+    {
+        return;
+    }
+
+    (entry->prev ? entry->prev->next : head) = entry->next;
+    (entry->next ? entry->next->prev : tail) = entry->prev;
+    entry->prev = entry->next = nullptr;
+    entry->list = nullptr;
+}
+
+std::vector<wayfire_view> focus_mru_t::get_views(int count,
+    const std::function<bool(wayfire_view)>& filter) const
+{
+    std::vector<wayfire_view> views;
+    for (auto entry = head; entry && (count < 0 || (int)views.size() < count); entry = entry->next)
+    {
+        if (!filter || filter(entry->view))
+        {
+            views.push_back(entry->view);
+        }
+    }
+
+    return views;
+}
+
+stacking_order_t::~stacking_order_t()
+{
+    for (auto& wset : wf::workspace_set_t::get_all())
+    {
+        wset->erase_data<wset_stacking_t>();
+    }
+}
+
+wset_stacking_t *stacking_order_t::get_order(wf::workspace_set_t *wset)
+{
+    if (wset->has_data<wset_stacking_t>())
+    {
+        return wset->get_data<wset_stacking_t>();
+    }
+
+    auto order = wset->get_data_safe<wset_stacking_t>();
+    order->on_children_changed = [order] (wf::scene::node_regen_instances_signal*)
+    {
+        order->dirty = true;
+    };
+    wset->get_node()->connect(&order->on_children_changed);
+    return order;
+}
+
+std::vector<wayfire_view> stacking_order_t::get_views(wf::workspace_set_t *wset, int count,
+    const std::function<bool(wayfire_view)>& filter)
+{
+    auto order = get_order(wset);
+    if (order->dirty)
+    {
+        order->views.clear();
+        for (auto& node : wset->get_node()->get_children())
+        {
+            if (auto view = wf::node_to_view(node))
+            {
+                order->views.push_back(view);
+            }
+        }
+
+        order->dirty = false;
+    }
+
+    /* Mapping a view does not always change the children, so check it here */
+    std::vector<wayfire_view> views;
+    for (auto& view : order->views)
+    {
+        if ((count >= 0) && ((int)views.size() >= count))
+        {
+            break;
+        }
+
+        if (view->is_mapped() && (!filter || filter(view)))
+        {
+            views.push_back(view);
+        }
+    }
+
+    return views;
+}
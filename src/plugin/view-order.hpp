@@ -0,0 +1,108 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <functional>
+#include <wayfire/object.hpp>
+#include <wayfire/view.hpp>
+#include <wayfire/scene.hpp>
+#include <wayfire/workspace-set.hpp>
+#include <wayfire/signal-definitions.hpp>
+
+class focus_mru_t;
+
+/* Link of a toplevel view in the MRU list, stored as custom data on the view */
+class mru_entry_t : public wf::custom_data_t
+{
+  public:
+    focus_mru_t *list = nullptr;
+    wayfire_view view;
+    mru_entry_t *prev = nullptr;
+    mru_entry_t *next = nullptr;
+
+    ~mru_entry_t();
+};
+
+/*
+ * Toplevel views ordered by most recent keyboard focus, kept up to date from
+ * focus changes, so reading the first N views does not sort all views by
+ * focus timestamp.
+ */
+class focus_mru_t
+{
+    mru_entry_t *head = nullptr;
+    mru_entry_t *tail = nullptr;
+
+    wf::signal::connection_t<wf::view_mapped_signal> on_view_mapped;
+    wf::signal::connection_t<wf::view_unmapped_signal> on_view_unmapped;
+    wf::signal::connection_t<wf::keyboard_focus_changed_signal> on_keyboard_focus_changed;
+
+    mru_entry_t *get_entry(wayfire_view view);
+    void link_front(mru_entry_t *entry);
+    void link_back(mru_entry_t *entry);
+
+  public:
+    focus_mru_t();
+    ~focus_mru_t();
+
+    void unlink(mru_entry_t *entry);
+
+    /*
+     * Up to count views (all if count is negative) for which filter returns
+     * true, most recently focused first. Without a filter only count entries
+     * are visited; with one, every entry may be.
+     */
+    std::vector<wayfire_view> get_views(int count,
+        const std::function<bool(wayfire_view)>& filter = nullptr) const;
+};
+
+/* Views of a workspace set, topmost first, stored as custom data on the set */
+class wset_stacking_t : public wf::custom_data_t
+{
+  public:
+    std::vector<wayfire_view> views;
+    /* Set when the children of the set's node change */
+    bool dirty = true;
+    wf::signal::connection_t<wf::scene::node_regen_instances_signal> on_children_changed;
+};
+
+/*
+ * Stacking order of each workspace set. Any restack, map or move to another
+ * set changes the children of the set's scene node, so a set's list is only
+ * read from the scene graph again after that, not on every request.
+ */
+class stacking_order_t
+{
+    wset_stacking_t *get_order(wf::workspace_set_t *wset);
+
+  public:
+    ~stacking_order_t();
+
+    /* Up to count mapped views (all if negative) for which filter returns
+     * true, topmost first */
+    std::vector<wayfire_view> get_views(wf::workspace_set_t *wset, int count,
+        const std::function<bool(wayfire_view)>& filter = nullptr);
+};
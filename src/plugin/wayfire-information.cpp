@@ -23,6 +23,8 @@
  */
 
 
+#include <unistd.h>
+#include <drm_fourcc.h>
 #include <sys/time.h>
 #include <wayfire/core.hpp>
 #include <wayfire/view.hpp>
@@ -39,6 +41,7 @@
 #include <wayfire/plugins/common/util.hpp>
 
 #include "wayfire-information.hpp"
+#include "wayfire-view-source.hpp"
 #include "wayfire-information-server-protocol.h"
 
 extern "C"
@@ -54,99 +57,222 @@ wf::plugin_activation_data_t grab_interface{
 static void bind_manager(wl_client *client, void *data,
     uint32_t version, uint32_t id);
 
-void wayfire_information::send_view_info(wayfire_view view)
+void wayfire_information::send_view_info(wayfire_view view, wl_resource *resource)
 {
     if (!view)
     {
-        if (ipc_call)
+        if (ipc_call && !resource)
         {
             ipc_response = wf::ipc::json_error("No view found");
             ipc_call = false;
         }
         return;
     }
-    if (ipc_call)
+    if (ipc_call && !resource)
     {
         ipc_response = wf::ipc::json_ok();
         ipc_response["info"] = view_to_json(view);
+        if (process_info.enabled())
+        {
+            ipc_response["info"]["process"] = process_info.to_json(get_view_pid(view));
+        }
+
         ipc_call = false;
         return;
     }
-    auto output = view->get_output();
-    if (!output)
+    if (!view->get_output())
     {
         return;
     }
 
-    std::string role;
-    switch (view->role)
-    {
-        case wf::VIEW_ROLE_TOPLEVEL:
-            role = "TOPLEVEL";
-            break;
-        case wf::VIEW_ROLE_UNMANAGED:
-            role = "UNMANAGED";
-            break;
-        case wf::VIEW_ROLE_DESKTOP_ENVIRONMENT:
-            role = "DESKTOP_ENVIRONMENT";
-            break;
-        default:
-            role = "UNKNOWN";
-            break;
-    }
-
-    auto og = output->get_screen_size();
-    auto ws = output->wset()->get_current_workspace();
-    auto wm = wf::view_bounding_box_up_to(view);
-    wf::point_t workspace = {
-        ws.x + (int)std::floor((wm.x + wm.width / 2.0) / og.width),
-        ws.y + (int)std::floor((wm.y + wm.height / 2.0) / og.height)
+    view_info_strings_t strings;
+    send_view_info_event(extract_view_info<FIELD_WIRE>(view, strings), resource);
+}
+
+void wayfire_information::send_view_info_event(const view_info_t& info, wl_resource *resource)
+{
+    auto args = view_info_to_wire(info);
+    for (auto r : client_resources)
+    {
+        if (resource && (r != resource))
+        {
+            continue;
+        }
+
+        std::apply([r] (auto... arg)
+        {
+            wf_info_base_send_view_info(r, arg...);
+        }, args);
+    }
+}
+
+void wayfire_information::send_frame_stats(wl_resource *resource,
+    wf::output_t *output, output_frame_stats_t *stats)
+{
+    auto summary = stats->summary();
+    wf_info_base_send_frame_stats(resource, output->get_id(),
+                                            output->to_string().c_str(),
+                                            summary.frames,
+                                            summary.presented,
+                                            summary.dropped,
+                                            summary.missed,
+                                            summary.frame_time.average(),
+                                            summary.frame_time.percentile(0.50),
+                                            summary.frame_time.percentile(0.99),
+                                            summary.frame_time.max_us,
+                                            summary.render_time.average(),
+                                            summary.render_time.percentile(0.99),
+                                            summary.render_time.max_us);
+}
+
+void wayfire_information::send_view_aggregate(wl_resource *resource,
+    const view_aggregate_t& aggregate)
+{
+    auto send_group = [resource] (uint32_t group, const char *app_id, int pid,
+                                  int output_id, int ws_x, int ws_y, const view_group_stats_t& stats)
+    {
+        wf_info_base_send_view_group(resource, group, app_id, pid, output_id, ws_x, ws_y,
+                                               stats.count,
+                                               stats.minimized,
+                                               stats.fullscreen,
+                                               uint32_t(stats.area >> 32),
+                                               uint32_t(stats.area));
     };
 
-    auto toplevel = toplevel_cast(view);
-    wf::geometry_t vg{0, 0, 0, 0};
-    if (toplevel)
+    send_group(0, "", -1, -1, -1, -1, aggregate.total);
+    for (auto& [app_id, stats] : aggregate.by_app_id)
+    {
+        send_group(GROUP_APP_ID, app_id.c_str(), -1, -1, -1, -1, stats);
+    }
+
+    for (auto& [pid, stats] : aggregate.by_pid)
+    {
+        send_group(GROUP_PID, "", pid, -1, -1, -1, stats);
+    }
+
+    for (auto& [output_id, stats] : aggregate.by_output)
+    {
+        send_group(GROUP_OUTPUT, "", -1, output_id, -1, -1, stats);
+    }
+
+    for (auto& [key, stats] : aggregate.by_workspace)
+    {
+        send_group(GROUP_WORKSPACE, "", -1, key.output_id, key.x, key.y, stats);
+    }
+
+    wf_info_base_send_done(resource);
+}
+
+/* Views included in a layout snapshot, over both IPC and the protocol. The
+ * view_info event has no way to express a missing output, so views without
+ * one are left out of both. */
+static bool is_layout_view(wayfire_view view)
+{
+    return (view->role == wf::VIEW_ROLE_TOPLEVEL ||
+            view->role == wf::VIEW_ROLE_DESKTOP_ENVIRONMENT) && view->get_output();
+}
+
+/* View info for replies listing many views, with process info only if it
+ * is already cached */
+wf::json_t wayfire_information::bulk_view_to_json(wayfire_view view)
+{
+    auto description = view_to_json(view);
+    if (process_info.enabled())
+    {
+        description["process"] = process_info.cached_json(get_view_pid(view));
+    }
+
+    return description;
+}
+
+wf::json_t wayfire_information::layout_snapshot_to_json()
+{
+    wf::json_t snapshot;
+    snapshot["outputs"] = wf::json_t::array();
+    for (auto& o : wf::get_core().output_layout->get_outputs())
     {
-        vg = toplevel->get_geometry();
+        snapshot["outputs"].append(output_to_json(o));
     }
 
-    pid_t pid = -1;
-    wlr_surface *wlr_surface = view->get_wlr_surface();
-    int is_xwayland_surface = 0;
-#if WF_HAS_XWAYLAND
-    is_xwayland_surface = wlr_surface && wlr_xwayland_surface_try_from_wlr_surface(wlr_surface);
-    if (is_xwayland_surface)
+    snapshot["wsets"] = wf::json_t::array();
+    for (auto& wset : wf::workspace_set_t::get_all())
     {
-        pid = wlr_xwayland_surface_try_from_wlr_surface(wlr_surface)->pid;
-    } else
-#endif
+        snapshot["wsets"].append(wset_to_json(wset.get()));
+    }
+
+    snapshot["views"] = wf::json_t::array();
+    for (auto& view : wf::get_core().get_all_views())
     {
-        if (view->get_client())
+        if (!is_layout_view(view))
         {
-            wl_client_get_credentials(view->get_client(), &pid, 0, 0);
+            continue;
         }
+
+        auto description = bulk_view_to_json(view);
+        description["children"] = wf::json_t::array();
+        if (auto toplevel = wf::toplevel_cast(view))
+        {
+            for (auto& child : toplevel->children)
+            {
+                description["children"].append((int)child->get_id());
+            }
+        }
+
+        snapshot["views"].append(description);
     }
 
-    int focused = wf::get_active_view_for_output(output) == view;
+    return snapshot;
+}
 
-    for (auto r : client_resources)
+void wayfire_information::send_layout_snapshot(wl_resource *resource)
+{
+    for (auto& o : wf::get_core().output_layout->get_outputs())
     {
-        wf_info_base_send_view_info(r, view->get_id(),
-                                       pid,
-                                       workspace.x,
-                                       workspace.y,
-                                       view->get_app_id().c_str(),
-                                       view->get_title().c_str(),
-                                       role.c_str(),
-                                       vg.x,
-                                       vg.y,
-                                       vg.width,
-                                       vg.height,
-                                       is_xwayland_surface,
-                                       focused,
-                                       output->to_string().c_str(),
-                                       output->get_id());
+        auto og = o->get_layout_geometry();
+        auto wa = o->workarea->get_workarea();
+        wf_info_base_send_output_info(resource, o->get_id(),
+                                                o->to_string().c_str(),
+                                                og.x,
+                                                og.y,
+                                                og.width,
+                                                og.height,
+                                                wa.x,
+                                                wa.y,
+                                                wa.width,
+                                                wa.height,
+                                                o->wset()->get_index());
+    }
+
+    for (auto& wset : wf::workspace_set_t::get_all())
+    {
+        auto output = wset->get_attached_output();
+        auto ws     = wset->get_current_workspace();
+        auto grid   = wset->get_workspace_grid_size();
+        wf_info_base_send_wset_info(resource, wset->get_index(),
+                                              wset->to_string().c_str(),
+                                              output ? (int)output->get_id() : -1,
+                                              ws.x,
+                                              ws.y,
+                                              grid.width,
+                                              grid.height);
+    }
+
+    for (auto& view : wf::get_core().get_all_views())
+    {
+        if (!is_layout_view(view))
+        {
+            continue;
+        }
+
+        send_view_info(view, resource);
+
+        auto toplevel = wf::toplevel_cast(view);
+        wf_info_base_send_view_layout(resource, view->get_id(),
+                                                toplevel && toplevel->parent ? (int)toplevel->parent->get_id() : -1,
+                                                toplevel && toplevel->get_wset() ? (int)toplevel->get_wset()->get_index() : -1);
     }
+
+    wf_info_base_send_done(resource);
 }
 
 void wayfire_information::deactivate()
@@ -183,7 +309,7 @@ void wayfire_information::set_base_ptr(wf::pointer_interaction_t *base)
 wayfire_information::wayfire_information()
 {
     manager = wl_global_create(wf::get_core().display,
-        &wf_info_base_interface, 1, this, bind_manager);
+        &wf_info_base_interface, WF_INFO_BASE_VERSION, this, bind_manager);
 
     if (!manager)
     {
@@ -223,13 +349,338 @@ wayfire_information::wayfire_information()
         return ipc_response;
     };
 
+    for (auto& o : wf::get_core().output_layout->get_outputs())
+    {
+        frame_stats[o] = std::make_unique<output_frame_stats_t>(o);
+    }
+
+    on_output_added = [=] (wf::output_added_signal *ev)
+    {
+        frame_stats[ev->output] = std::make_unique<output_frame_stats_t>(ev->output);
+    };
+    on_output_pre_remove = [=] (wf::output_pre_remove_signal *ev)
+    {
+        frame_stats.erase(ev->output);
+    };
+    wf::get_core().output_layout->connect(&on_output_added);
+    wf::get_core().output_layout->connect(&on_output_pre_remove);
+
+    get_frame_stats_ipc = [=] (wf::json_t data)
+    {
+        WFJSON_OPTIONAL_FIELD(data, "output-id", int);
+
+        auto response = wf::ipc::json_ok();
+        response["outputs"] = wf::json_t::array();
+        for (auto& [o, stats] : frame_stats)
+        {
+            if (data.has_member("output-id") && (int(o->get_id()) != data["output-id"].as_int()))
+            {
+                continue;
+            }
+
+            response["outputs"].append(stats->to_json());
+        }
+
+        return response;
+    };
+
+    reset_frame_stats_ipc = [=] (wf::json_t data)
+    {
+        WFJSON_OPTIONAL_FIELD(data, "output-id", int);
+
+        for (auto& [o, stats] : frame_stats)
+        {
+            if (data.has_member("output-id") && (int(o->get_id()) != data["output-id"].as_int()))
+            {
+                continue;
+            }
+
+            stats->reset();
+        }
+
+        return wf::ipc::json_ok();
+    };
+
+    get_launch_stats_ipc = [=] (wf::json_t data)
+    {
+        WFJSON_OPTIONAL_FIELD(data, "app-id", string);
+
+        auto response = wf::ipc::json_ok();
+        response["apps"] = lifecycle_tracker.app_stats_to_json(
+            data.has_member("app-id") ? data["app-id"].as_string() : "");
+        return response;
+    };
+
+    reset_launch_stats_ipc = [=] (wf::json_t data)
+    {
+        lifecycle_tracker.reset();
+        return wf::ipc::json_ok();
+    };
+
+    get_timeline_ipc = [=] (wf::json_t data)
+    {
+        WFJSON_OPTIONAL_FIELD(data, "clear", bool);
+
+        if (!timeline.enabled())
+        {
+            return wf::ipc::json_error("Timeline recorder is disabled, set wf-info/timeline_size.");
+        }
+
+        auto response = wf::ipc::json_ok();
+        response["events"] = timeline.to_json();
+        if (data.has_member("clear") && data["clear"].as_bool())
+        {
+            timeline.clear();
+        }
+
+        return response;
+    };
+
+    /* Warm up the process info cache so it is usually ready when asked */
+    on_view_mapped = [=] (wf::view_mapped_signal *ev)
+    {
+        process_info.get(get_view_pid(ev->view));
+    };
+    wf::get_core().connect(&on_view_mapped);
+
+    get_process_info_ipc = [=] (wf::json_t data)
+    {
+        WFJSON_OPTIONAL_FIELD(data, "pid", int);
+        WFJSON_OPTIONAL_FIELD(data, "view-id", int);
+
+        if (!process_info.enabled())
+        {
+            return wf::ipc::json_error("Process info is disabled, set wf-info/process_info.");
+        }
+
+        pid_t pid = -1;
+        if (data.has_member("pid"))
+        {
+            pid = data["pid"].as_int();
+        } else if (data.has_member("view-id"))
+        {
+            auto view = wf::ipc::find_view_by_id(data["view-id"].as_int());
+            if (!view)
+            {
+                return wf::ipc::json_error("No view found");
+            }
+
+            pid = get_view_pid(view);
+        } else
+        {
+            return wf::ipc::json_error("Missing \"pid\" or \"view-id\"");
+        }
+
+        /* Not cached yet means the helper is reading it now */
+        auto response = wf::ipc::json_ok();
+        response["process"] = process_info.to_json(pid);
+        response["pending"] = response["process"].is_null();
+        return response;
+    };
+
+    get_layout_snapshot_ipc = [=] (wf::json_t data)
+    {
+        auto response = wf::ipc::json_ok();
+        response["snapshot"] = layout_snapshot_to_json();
+        return response;
+    };
+
+    get_mru_views_ipc = [=] (wf::json_t data)
+    {
+        WFJSON_OPTIONAL_FIELD(data, "count", int);
+        WFJSON_OPTIONAL_FIELD(data, "output-id", int);
+        WFJSON_OPTIONAL_FIELD(data, "workspace-x", int);
+        WFJSON_OPTIONAL_FIELD(data, "workspace-y", int);
+
+        int count = data.has_member("count") ? data["count"].as_int() : -1;
+        int output_id = data.has_member("output-id") ? data["output-id"].as_int() : -1;
+        bool filter_ws = data.has_member("workspace-x") && data.has_member("workspace-y");
+        wf::point_t ws = filter_ws ?
+            wf::point_t{data["workspace-x"].as_int(), data["workspace-y"].as_int()} : wf::point_t{0, 0};
+
+        auto response = wf::ipc::json_ok();
+        response["views"] = wf::json_t::array();
+        auto views = focus_mru.get_views(count, [&] (wayfire_view view)
+        {
+            auto output = view->get_output();
+            if ((output_id != -1) && (!output || (int(output->get_id()) != output_id)))
+            {
+                return false;
+            }
+
+            return !filter_ws || (output && (get_view_workspace(view, output) == ws));
+        });
+        for (auto& view : views)
+        {
+            response["views"].append(bulk_view_to_json(view));
+        }
+
+        return response;
+    };
+
+    get_stacking_order_ipc = [=] (wf::json_t data)
+    {
+        WFJSON_OPTIONAL_FIELD(data, "count", int);
+        WFJSON_OPTIONAL_FIELD(data, "output-id", int);
+        WFJSON_OPTIONAL_FIELD(data, "wset-index", int);
+
+        wf::workspace_set_t *wset = nullptr;
+        if (data.has_member("wset-index"))
+        {
+            for (auto& w : wf::workspace_set_t::get_all())
+            {
+                if (int(w->get_index()) == data["wset-index"].as_int())
+                {
+                    wset = w.get();
+                }
+            }
+        } else if (data.has_member("output-id"))
+        {
+            auto output = wf::ipc::find_output_by_id(data["output-id"].as_int());
+            wset = output ? output->wset().get() : nullptr;
+        } else if (auto output = wf::get_core().seat->get_active_output())
+        {
+            wset = output->wset().get();
+        }
+
+        if (!wset)
+        {
+            return wf::ipc::json_error("No workspace set found");
+        }
+
+        auto response = wf::ipc::json_ok();
+        response["wset-index"] = wset->get_index();
+        response["views"] = wf::json_t::array();
+        int count = data.has_member("count") ? data["count"].as_int() : -1;
+        for (auto& view : stacking_order.get_views(wset, count))
+        {
+            response["views"].append(bulk_view_to_json(view));
+        }
+
+        return response;
+    };
+
+    aggregate_views_ipc = [=] (wf::json_t data)
+    {
+        WFJSON_OPTIONAL_FIELD(data, "group-by", array);
+        WFJSON_OPTIONAL_FIELD(data, "role", string);
+        WFJSON_OPTIONAL_FIELD(data, "app-id", string);
+        WFJSON_OPTIONAL_FIELD(data, "output-id", int);
+
+        uint32_t groups = GROUP_ALL;
+        if (data.has_member("group-by"))
+        {
+            groups = 0;
+            for (size_t i = 0; i < data["group-by"].size(); i++)
+            {
+                auto& group = data["group-by"][i];
+                std::string name = group.is_string() ? group.as_string() : "";
+                if (name == "app-id")
+                {
+                    groups |= GROUP_APP_ID;
+                } else if (name == "pid")
+                {
+                    groups |= GROUP_PID;
+                } else if (name == "output")
+                {
+                    groups |= GROUP_OUTPUT;
+                } else if (name == "workspace")
+                {
+                    groups |= GROUP_WORKSPACE;
+                } else
+                {
+                    return wf::ipc::json_error("Unknown group \"" + name +
+                        "\", expected app-id, pid, output or workspace");
+                }
+            }
+        }
+
+        std::string role   = data.has_member("role") ? data["role"].as_string() : "toplevel";
+        std::string app_id = data.has_member("app-id") ? data["app-id"].as_string() : "";
+        view_filter_t filter;
+        filter.roles     = {role};
+        filter.app_id    = app_id;
+        filter.output_id = data.has_member("output-id") ? data["output-id"].as_int() : -1;
+
+        wayfire_view_source_t<FIELD_AGGREGATE> source;
+        auto response = wf::ipc::json_ok();
+        response["aggregate"] = view_aggregate_to_json(aggregate_views(source, filter, groups));
+        return response;
+    };
+
+    dump_scene_ipc = [=] (wf::json_t data)
+    {
+        WFJSON_OPTIONAL_FIELD(data, "view-id", int);
+
+        wf::scene::node_t *root = wf::get_core().scene().get();
+        if (data.has_member("view-id"))
+        {
+            auto view = wf::ipc::find_view_by_id(data["view-id"].as_int());
+            if (!view)
+            {
+                return wf::ipc::json_error("No view found");
+            }
+
+            root = view->get_surface_root_node().get();
+        }
+
+        auto response = wf::ipc::json_ok();
+        response["scene"] = scene_to_json(root, scene_damage);
+        response["damage-frames"]    = scene_damage.frames;
+        response["damage-recording"] = scene_damage.recording();
+        return response;
+    };
+
+    record_scene_damage_ipc = [=] (wf::json_t data)
+    {
+        WFJSON_OPTIONAL_FIELD(data, "frames", int);
+
+        int frames = data.has_member("frames") ? data["frames"].as_int() : 60;
+        if (frames <= 0)
+        {
+            scene_damage.clear();
+        } else
+        {
+            scene_damage.start(frames);
+        }
+
+        return wf::ipc::json_ok();
+    };
+
     ipc_repo->register_method("wf-info/get_view_info", get_view_info_ipc);
+    ipc_repo->register_method("wf-info/get_frame_stats", get_frame_stats_ipc);
+    ipc_repo->register_method("wf-info/reset_frame_stats", reset_frame_stats_ipc);
+    ipc_repo->register_method("wf-info/get_launch_stats", get_launch_stats_ipc);
+    ipc_repo->register_method("wf-info/reset_launch_stats", reset_launch_stats_ipc);
+    ipc_repo->register_method("wf-info/get_timeline", get_timeline_ipc);
+    ipc_repo->register_method("wf-info/get_process_info", get_process_info_ipc);
+    ipc_repo->register_method("wf-info/get_layout_snapshot", get_layout_snapshot_ipc);
+    ipc_repo->register_method("wf-info/get_mru_views", get_mru_views_ipc);
+    ipc_repo->register_method("wf-info/get_stacking_order", get_stacking_order_ipc);
+    ipc_repo->register_method("wf-info/aggregate_views", aggregate_views_ipc);
+    ipc_repo->register_method("wf-info/dump_scene", dump_scene_ipc);
+    ipc_repo->register_method("wf-info/record_scene_damage", record_scene_damage_ipc);
 }
 
 wayfire_information::~wayfire_information()
 {
     wl_global_destroy(manager);
 
+    ipc_repo->unregister_method("wf-info/get_view_info");
+    ipc_repo->unregister_method("wf-info/get_frame_stats");
+    ipc_repo->unregister_method("wf-info/reset_frame_stats");
+    ipc_repo->unregister_method("wf-info/get_launch_stats");
+    ipc_repo->unregister_method("wf-info/reset_launch_stats");
+    ipc_repo->unregister_method("wf-info/get_timeline");
+    ipc_repo->unregister_method("wf-info/get_process_info");
+    ipc_repo->unregister_method("wf-info/get_layout_snapshot");
+    ipc_repo->unregister_method("wf-info/get_mru_views");
+    ipc_repo->unregister_method("wf-info/get_stacking_order");
+    ipc_repo->unregister_method("wf-info/aggregate_views");
+    ipc_repo->unregister_method("wf-info/dump_scene");
+    ipc_repo->unregister_method("wf-info/record_scene_damage");
+    frame_stats.clear();
+
     for (auto& o : wf::get_core().output_layout->get_outputs())
     {
         input_grabs[o].reset();
@@ -305,15 +756,19 @@ static void send_all_views(struct wl_client *client, struct wl_resource *resourc
 {
     wayfire_information *wd = (wayfire_information*)wl_resource_get_user_data(resource);
 
-    for (auto& view : wf::get_core().get_all_views())
+    view_filter_t filter;
+    filter.roles = {role_to_string(wf::VIEW_ROLE_TOPLEVEL),
+        role_to_string(wf::VIEW_ROLE_DESKTOP_ENVIRONMENT)};
+    filter.require_output = true;
+
+    wayfire_view_source_t<FIELD_WIRE> source;
+    source.for_each_view([&] (const view_info_t& info)
     {
-        if (view->role != wf::VIEW_ROLE_TOPLEVEL &&
-            view->role != wf::VIEW_ROLE_DESKTOP_ENVIRONMENT)
+        if (filter.matches(info))
         {
-            continue;
+            wd->send_view_info_event(info);
         }
-        wd->send_view_info(view);
-    }
+    });
 
     for (auto r : wd->client_resources)
     {
@@ -321,11 +776,154 @@ static void send_all_views(struct wl_client *client, struct wl_resource *resourc
     }
 }
 
+static void send_frame_stats(struct wl_client *client, struct wl_resource *resource, int output_id)
+{
+    wayfire_information *wd = (wayfire_information*)wl_resource_get_user_data(resource);
+
+    for (auto& [o, stats] : wd->frame_stats)
+    {
+        if ((output_id != -1) && (int(o->get_id()) != output_id))
+        {
+            continue;
+        }
+
+        wd->send_frame_stats(resource, o, stats.get());
+    }
+
+    wf_info_base_send_done(resource);
+}
+
+static void reset_frame_stats(struct wl_client *client, struct wl_resource *resource, int output_id)
+{
+    wayfire_information *wd = (wayfire_information*)wl_resource_get_user_data(resource);
+
+    for (auto& [o, stats] : wd->frame_stats)
+    {
+        if ((output_id != -1) && (int(o->get_id()) != output_id))
+        {
+            continue;
+        }
+
+        stats->reset();
+    }
+
+    wf_info_base_send_done(resource);
+}
+
+static void send_timeline(struct wl_client *client, struct wl_resource *resource)
+{
+    wayfire_information *wd = (wayfire_information*)wl_resource_get_user_data(resource);
+
+    uint32_t count = 0;
+    int fd = wd->timeline.to_memfd(count);
+    if (fd < 0)
+    {
+        LOGE("Failed to create timeline memfd");
+        wl_client_post_no_memory(client);
+        return;
+    }
+
+    wf_info_base_send_timeline(resource, fd, sizeof(timeline_record_t), count);
+    close(fd);
+
+    wf_info_base_send_done(resource);
+}
+
+static void send_layout_snapshot(struct wl_client *client, struct wl_resource *resource)
+{
+    wayfire_information *wd = (wayfire_information*)wl_resource_get_user_data(resource);
+
+    wd->send_layout_snapshot(resource);
+}
+
+static void send_mru_views(struct wl_client *client, struct wl_resource *resource,
+    int count, int output_id)
+{
+    wayfire_information *wd = (wayfire_information*)wl_resource_get_user_data(resource);
+
+    auto views = wd->focus_mru.get_views(count, [output_id] (wayfire_view view)
+    {
+        auto output = view->get_output();
+        return output && ((output_id == -1) || (int(output->get_id()) == output_id));
+    });
+    for (auto& view : views)
+    {
+        wd->send_view_info(view, resource);
+    }
+
+    wf_info_base_send_done(resource);
+}
+
+static void send_stacking_order(struct wl_client *client, struct wl_resource *resource,
+    int count, int output_id)
+{
+    wayfire_information *wd = (wayfire_information*)wl_resource_get_user_data(resource);
+
+    auto output = (output_id == -1) ? wf::get_core().seat->get_active_output() :
+        wf::ipc::find_output_by_id(output_id);
+    if (output)
+    {
+        for (auto& view : wd->stacking_order.get_views(output->wset().get(), count))
+        {
+            wd->send_view_info(view, resource);
+        }
+    }
+
+    wf_info_base_send_done(resource);
+}
+
+static void send_aggregate(struct wl_client *client, struct wl_resource *resource,
+    uint32_t group_by, int output_id)
+{
+    wayfire_information *wd = (wayfire_information*)wl_resource_get_user_data(resource);
+
+    view_filter_t filter;
+    filter.roles     = {role_to_string(wf::VIEW_ROLE_TOPLEVEL)};
+    filter.output_id = output_id;
+
+    wayfire_view_source_t<FIELD_AGGREGATE> source;
+    wd->send_view_aggregate(resource, aggregate_views(source, filter, group_by & GROUP_ALL));
+}
+
+static void send_thumbnail(struct wl_client *client, struct wl_resource *resource,
+    uint32_t view_id, int max_width, int max_height)
+{
+    wayfire_information *wd = (wayfire_information*)wl_resource_get_user_data(resource);
+
+    auto view = wf::ipc::find_view_by_id(view_id);
+    if (auto thumbnail = wd->thumbnails.get(view, {max_width, max_height}))
+    {
+        int fd = thumbnail->get_fd();
+        if (fd < 0)
+        {
+            LOGE("Failed to create thumbnail memfd");
+            wl_client_post_no_memory(client);
+            return;
+        }
+
+        wf_info_base_send_thumbnail(resource, view_id, fd,
+                                              thumbnail->size.width,
+                                              thumbnail->size.height,
+                                              thumbnail->size.width * 4,
+                                              DRM_FORMAT_ARGB8888);
+    }
+
+    wf_info_base_send_done(resource);
+}
+
 static const struct wf_info_base_interface wayfire_information_impl =
 {
     .view_info      = get_view_info,
     .view_info_id   = send_view_info_from_id,
     .view_info_list = send_all_views,
+    .frame_stats    = send_frame_stats,
+    .reset_frame_stats = reset_frame_stats,
+    .timeline = send_timeline,
+    .layout_snapshot = send_layout_snapshot,
+    .mru_views = send_mru_views,
+    .stacking_order = send_stacking_order,
+    .aggregate = send_aggregate,
+    .thumbnail = send_thumbnail,
 };
 
 static void destroy_client(wl_resource *resource)
@@ -349,7 +947,7 @@ static void bind_manager(wl_client *client, void *data,
     wayfire_information *wd = (wayfire_information*)data;
 
     auto resource =
-        wl_resource_create(client, &wf_info_base_interface, 1, id);
+        wl_resource_create(client, &wf_info_base_interface, version, id);
     wl_resource_set_implementation(resource,
         &wayfire_information_impl, data, destroy_client);
     wd->client_resources.push_back(resource);
@@ -26,10 +26,20 @@
 #pragma once
 
 #include <wayfire/nonstd/json.hpp>
+#include <wayfire/signal-definitions.hpp>
 #include <wayfire/plugins/common/input-grab.hpp>
 #include <wayfire/plugins/common/shared-core-data.hpp>
 #include <wayfire/plugins/ipc/ipc-method-repository.hpp>
 #include "ipc-rules-common.hpp"
+#include "frame-stats.hpp"
+#include "view-lifecycle.hpp"
+#include "timeline.hpp"
+#include "process-info.hpp"
+#include "view-order.hpp"
+#include "thumbnail.hpp"
+#include "scene-dump.hpp"
+
+#define WF_INFO_BASE_VERSION 7
 
 class wayfire_information
 {
@@ -38,7 +48,13 @@ class wayfire_information
   public:
     wf::pointer_interaction_t *base;
     std::vector<wl_resource*> client_resources;
-    void send_view_info(wayfire_view view);
+    void send_view_info(wayfire_view view, wl_resource *resource = nullptr);
+    void send_view_info_event(const view_info_t& info, wl_resource *resource = nullptr);
+    void send_layout_snapshot(wl_resource *resource);
+    wf::json_t layout_snapshot_to_json();
+    wf::json_t bulk_view_to_json(wayfire_view view);
+    void send_frame_stats(wl_resource *resource, wf::output_t *output,
+        output_frame_stats_t *stats);
     void deactivate();
     void set_base_ptr(wf::pointer_interaction_t *base);
     wf::wl_idle_call idle_set_cursor;
@@ -47,6 +63,30 @@ class wayfire_information
     bool wl_call = false;
     wf::json_t ipc_response;
     wf::ipc::method_callback get_view_info_ipc;
+    wf::ipc::method_callback get_frame_stats_ipc;
+    wf::ipc::method_callback reset_frame_stats_ipc;
+    wf::ipc::method_callback get_launch_stats_ipc;
+    wf::ipc::method_callback reset_launch_stats_ipc;
+    view_lifecycle_tracker_t lifecycle_tracker;
+    wf::ipc::method_callback get_timeline_ipc;
+    event_timeline_t timeline;
+    wf::ipc::method_callback get_process_info_ipc;
+    wf::ipc::method_callback get_layout_snapshot_ipc;
+    process_info_cache_t process_info;
+    wf::ipc::method_callback get_mru_views_ipc;
+    wf::ipc::method_callback get_stacking_order_ipc;
+    focus_mru_t focus_mru;
+    stacking_order_t stacking_order;
+    wf::ipc::method_callback aggregate_views_ipc;
+    void send_view_aggregate(wl_resource *resource, const view_aggregate_t& aggregate);
+    thumbnail_cache_t thumbnails;
+    wf::ipc::method_callback dump_scene_ipc;
+    wf::ipc::method_callback record_scene_damage_ipc;
+    scene_damage_recorder_t scene_damage;
+    wf::signal::connection_t<wf::view_mapped_signal> on_view_mapped;
+    std::map<wf::output_t*, std::unique_ptr<output_frame_stats_t>> frame_stats;
+    wf::signal::connection_t<wf::output_added_signal> on_output_added;
+    wf::signal::connection_t<wf::output_pre_remove_signal> on_output_pre_remove;
     wf::shared_data::ref_ptr_t<wf::ipc::method_repository_t> ipc_repo;
     void end_grab();
     wayfire_information();
@@ -0,0 +1,52 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <wayfire/core.hpp>
+#include <wayfire/output-layout.hpp>
+
+#include "ipc-rules-common.hpp"
+#include "view-source.hpp"
+
+/*
+ * view_source_t backed by the running compositor. Only the view fields
+ * selected by Mask are filled in.
+ */
+template<uint32_t Mask = FIELD_JSON | FIELD_WIRE>
+class wayfire_view_source_t : public view_source_t
+{
+    /* Reused for every view, the info passed out borrows from it */
+    view_info_strings_t strings;
+
+  public:
+    void for_each_view(const std::function<void(const view_info_t&)>& callback) override
+    {
+        for (auto& view : wf::get_core().get_all_views())
+        {
+            callback(extract_view_info<Mask>(view, strings));
+        }
+    }
+};
@@ -0,0 +1,501 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Scott Moreau
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+ * Tests of the compositor-independent info core. Run with meson test.
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "info-core.hpp"
+#include "view-aggregate.hpp"
+#include "timeline-record.hpp"
+#include "process-record.hpp"
+#include "downscale.hpp"
+
+static int failures;
+
+#define CHECK(expr) \
+    do { \
+        if (!(expr)) \
+        { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+            failures++; \
+        } \
+    } while (0)
+
+template<uint32_t Mask>
+static void check_view_json(const view_info_t& info, std::string_view expected)
+{
+    std::string buffer = "stale";
+    buffer.clear();
+    append_view_json<Mask>(buffer, info);
+    CHECK(buffer == expected);
+    if (buffer != expected)
+    {
+        fprintf(stderr, "got:      %s\nexpected: %s\n", buffer.c_str(), std::string(expected).c_str());
+    }
+}
+
+static void test_view_json()
+{
+    std::string app_id = "org.example.\"quoted\"\\app";
+    std::string title  = std::string("tab\tnew\nline bell\x07 ctrl\x1f del\x7f utf-8 \xc3\xa9");
+
+    view_info_t info;
+    info.id  = 4294967295u;
+    info.pid = -1;
+    info.app_id = app_id;
+    info.title  = title;
+    info.role   = "toplevel";
+    info.geometry = {-2147483647 - 1, -5, 0, 2147483647};
+    info.xwayland = true;
+    info.focused  = false;
+    info.output_name   = "DP-1";
+    info.output_id     = -1;
+    info.base_geometry = {1, 2, 3, 4};
+    info.bbox   = {-10, -20, 30, 40};
+    info.parent = 17;
+    info.last_focus_timestamp = INT64_MIN;
+    info.mapped = true;
+    info.layer  = "workspace";
+    info.tiled_edges = 15;
+    info.fullscreen  = true;
+    info.minimized   = false;
+    info.activated   = true;
+    info.sticky      = false;
+    info.wset_index  = 3;
+    info.min_size    = {0, 0};
+    info.max_size    = {-1, 100000};
+    info.focusable   = true;
+    info.type = "x-or";
+
+    /* Control characters are escaped, other bytes are copied as they are */
+    const std::string wire_fields =
+        "{\"id\":4294967295,\"pid\":-1,\"workspace\":null,"
+        "\"app-id\":\"org.example.\\\"quoted\\\"\\\\app\","
+        "\"title\":\"tab\\tnew\\nline bell\\u0007 ctrl\\u001f del\x7f utf-8 \xc3\xa9\","
+        "\"role\":\"toplevel\","
+        "\"geometry\":{\"x\":-2147483648,\"y\":-5,\"width\":0,\"height\":2147483647},"
+        "\"xwayland\":true,\"focused\":false,\"output-name\":\"DP-1\",\"output-id\":-1";
+
+    check_view_json<FIELD_WIRE>(info, wire_fields + "}");
+    check_view_json<FIELD_JSON>(info, wire_fields +
+        ",\"base-geometry\":{\"x\":1,\"y\":2,\"width\":3,\"height\":4},"
+        "\"bbox\":{\"x\":-10,\"y\":-20,\"width\":30,\"height\":40},"
+        "\"parent\":17,\"last-focus-timestamp\":-9223372036854775808,\"mapped\":true,"
+        "\"layer\":\"workspace\",\"tiled-edges\":15,\"fullscreen\":true,\"minimized\":false,"
+        "\"activated\":true,\"sticky\":false,\"wset-index\":3,"
+        "\"min-size\":{\"width\":0,\"height\":0},\"max-size\":{\"width\":-1,\"height\":100000},"
+        "\"focusable\":true,\"type\":\"x-or\"}");
+
+    info.workspace = info_point_t{-1, 2};
+    info.title     = "";
+    check_view_json<FIELD_WIRE>(info,
+        "{\"id\":4294967295,\"pid\":-1,\"workspace\":{\"x\":-1,\"y\":2},"
+        "\"app-id\":\"org.example.\\\"quoted\\\"\\\\app\",\"title\":\"\",\"role\":\"toplevel\","
+        "\"geometry\":{\"x\":-2147483648,\"y\":-5,\"width\":0,\"height\":2147483647},"
+        "\"xwayland\":true,\"focused\":false,\"output-name\":\"DP-1\",\"output-id\":-1}");
+}
+
+static void test_view_wire()
+{
+    view_info_t info;
+    info.id = 7;
+    info.title  = "title";
+    info.role   = "desktop-environment";
+    info.output_name = "DP-1";
+    info.output_id   = 2;
+    info.workspace   = info_point_t{1, 0};
+
+    auto args = view_info_to_wire(info);
+    CHECK(std::string_view(std::get<6>(args)) == "DESKTOP_ENVIRONMENT");
+
+    auto decoded = std::apply([] (auto... arg) { return view_info_from_wire(arg...); }, args);
+    CHECK(decoded.id == 7 && decoded.title == "title" && decoded.output_id == 2);
+    CHECK(decoded.role == "DESKTOP_ENVIRONMENT");
+    CHECK(decoded.workspace && (decoded.workspace->x == 1));
+
+    CHECK(std::string_view(role_to_wire("toplevel")) == "TOPLEVEL");
+    CHECK(std::string_view(role_to_wire("")) == "UNKNOWN");
+}
+
+static void test_workspace()
+{
+    info_size_t screen = {1920, 1080};
+    info_point_t current = {1, 1};
+
+    auto ws = compute_workspace({0, 0, 100, 100}, screen, current);
+    CHECK(ws.x == 1 && ws.y == 1);
+
+    /* Left of and above the current workspace */
+    ws = compute_workspace({-100, -100, 50, 50}, screen, current);
+    CHECK(ws.x == 0 && ws.y == 0);
+
+    /* Two workspaces away in the negative direction */
+    ws = compute_workspace({-1920 * 2 + 10, -1080 * 2 + 10, 20, 20}, screen, current);
+    CHECK(ws.x == -1 && ws.y == -1);
+
+    /* Spanning two workspaces, the one with the center wins */
+    ws = compute_workspace({1800, 0, 400, 100}, screen, current);
+    CHECK(ws.x == 2 && ws.y == 1);
+    ws = compute_workspace({-300, 1000, 400, 100}, screen, current);
+    CHECK(ws.x == 0 && ws.y == 1);
+
+    /* Spanning a workspace boundary at a negative coordinate */
+    ws = compute_workspace({-1000, -600, 200, 100}, screen, current);
+    CHECK(ws.x == 0 && ws.y == 0);
+
+    /* A center exactly on a boundary belongs to the workspace after it */
+    ws = compute_workspace({1820, 980, 200, 200}, screen, current);
+    CHECK(ws.x == 2 && ws.y == 2);
+    ws = compute_workspace({-100, -100, 200, 200}, screen, current);
+    CHECK(ws.x == 1 && ws.y == 1);
+
+    /* Larger than the output */
+    ws = compute_workspace({-1920, -1080, 1920 * 3, 1080 * 3}, screen, current);
+    CHECK(ws.x == 1 && ws.y == 1);
+
+    /* Odd size, the center is at -0.5 */
+    ws = compute_workspace({-1, 0, 1, 1}, screen, {0, 0});
+    CHECK(ws.x == -1 && ws.y == 0);
+}
+
+static void test_filter()
+{
+    view_info_t toplevel;
+    toplevel.app_id    = "a";
+    toplevel.role      = "toplevel";
+    toplevel.output_id = 2;
+
+    view_info_t unmanaged;
+    unmanaged.app_id    = "b";
+    unmanaged.role      = "unmanaged";
+    unmanaged.output_id = -1;
+
+    view_filter_t filter;
+    CHECK(filter.matches(toplevel));
+    CHECK(filter.matches(unmanaged));
+
+    filter.require_output = true;
+    CHECK(filter.matches(toplevel));
+    CHECK(!filter.matches(unmanaged));
+
+    filter = {};
+    filter.roles = {"toplevel", "desktop-environment"};
+    CHECK(filter.matches(toplevel));
+    CHECK(!filter.matches(unmanaged));
+
+    filter = {};
+    filter.app_id = "b";
+    CHECK(!filter.matches(toplevel));
+    CHECK(filter.matches(unmanaged));
+
+    /* A prefix is not a match */
+    toplevel.app_id = "bb";
+    CHECK(!filter.matches(toplevel));
+
+    filter = {};
+    filter.output_id = 2;
+    CHECK(filter.matches(toplevel));
+    CHECK(!filter.matches(unmanaged));
+
+    filter.output_id = 3;
+    CHECK(!filter.matches(toplevel));
+
+    /* Views without an output never match an output filter */
+    filter.output_id = -1;
+    filter.require_output = true;
+    CHECK(!filter.matches(unmanaged));
+
+    /* All conditions must hold */
+    filter = {};
+    filter.roles  = {"toplevel"};
+    filter.app_id = "bb";
+    filter.output_id = 2;
+    CHECK(filter.matches(toplevel));
+    toplevel.role = "unmanaged";
+    CHECK(!filter.matches(toplevel));
+}
+
+static void test_timeline_ring()
+{
+    timeline_ring_t ring;
+    CHECK(ring.capacity() == 0);
+    CHECK(ring.snapshot().empty());
+
+    /* Rounded up to a power of two */
+    ring.resize(5);
+    CHECK(ring.capacity() == 8);
+    CHECK(ring.snapshot().empty());
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        ring.record(TIMELINE_EVENT_FOCUS, i);
+    }
+
+    auto events = ring.snapshot();
+    CHECK(events.size() == 3);
+    for (uint32_t i = 0; i < events.size(); i++)
+    {
+        CHECK(events[i].view_id == i);
+    }
+
+    /* Wrap around a few times, the last 8 are kept oldest first */
+    for (uint32_t i = 3; i < 21; i++)
+    {
+        ring.record(TIMELINE_EVENT_GEOMETRY, i, i, -int32_t(i), 2, 3);
+    }
+
+    events = ring.snapshot();
+    CHECK(events.size() == 8);
+    for (uint32_t i = 0; i < events.size(); i++)
+    {
+        CHECK(events[i].view_id == 13 + i);
+        CHECK(events[i].type == TIMELINE_EVENT_GEOMETRY);
+        CHECK(events[i].data[0] == int32_t(13 + i));
+        CHECK(events[i].data[1] == -int32_t(13 + i));
+        if (i > 0)
+        {
+            CHECK(events[i].timestamp_ns >= events[i - 1].timestamp_ns);
+        }
+    }
+
+    /* Exactly full */
+    ring.clear();
+    CHECK(ring.snapshot().empty());
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        ring.record(TIMELINE_EVENT_MAP, 100 + i);
+    }
+
+    events = ring.snapshot();
+    CHECK(events.size() == 8);
+    CHECK(events.front().view_id == 100);
+    CHECK(events.back().view_id == 107);
+
+    /* One more drops the oldest */
+    ring.record(TIMELINE_EVENT_UNMAP, 108);
+    events = ring.snapshot();
+    CHECK(events.size() == 8);
+    CHECK(events.front().view_id == 101);
+    CHECK(events.back().view_id == 108);
+
+    ring.resize(0);
+    CHECK(ring.capacity() == 0);
+    CHECK(ring.snapshot().empty());
+}
+
+/* Views from a vector */
+class vector_view_source_t : public view_source_t
+{
+  public:
+    std::vector<view_info_t> views;
+
+    void for_each_view(const std::function<void(const view_info_t&)>& callback) override
+    {
+        for (auto& view : views)
+        {
+            callback(view);
+        }
+    }
+};
+
+static void test_aggregate()
+{
+    vector_view_source_t source;
+    view_info_t view;
+    view.app_id    = "a";
+    view.pid       = 10;
+    view.role      = "toplevel";
+    view.output_id = 1;
+    view.workspace = info_point_t{-1, 0};
+    view.geometry  = {0, 0, 10, 20};
+    view.mapped    = true;
+    source.views.push_back(view);
+
+    view.minimized = true;
+    source.views.push_back(view);
+
+    view.minimized  = false;
+    view.fullscreen = true;
+    view.app_id     = "b";
+    view.output_id  = -1;
+    view.workspace  = std::nullopt;
+    source.views.push_back(view);
+
+    /* Unmapped views are never counted */
+    view.mapped = false;
+    view.app_id = "a";
+    view.output_id = 1;
+    source.views.push_back(view);
+
+    view_filter_t filter;
+    filter.roles = {"toplevel"};
+    auto aggregate = aggregate_views(source, filter, GROUP_ALL);
+    CHECK(aggregate.total.count == 3);
+    CHECK(aggregate.total.minimized == 1);
+    CHECK(aggregate.total.fullscreen == 1);
+    CHECK(aggregate.total.area == 400);
+    CHECK(aggregate.by_app_id.size() == 2);
+    CHECK(aggregate.by_app_id["a"].count == 2);
+    CHECK(aggregate.by_app_id["a"].area == 200);
+    CHECK(aggregate.by_pid[10].count == 3);
+    CHECK(aggregate.by_output.size() == 1);
+    CHECK(aggregate.by_output[1].count == 2);
+    CHECK(aggregate.by_workspace.size() == 1);
+    CHECK((aggregate.by_workspace[{1, -1, 0}].count == 2));
+
+    aggregate = aggregate_views(source, filter, GROUP_PID);
+    CHECK(aggregate.total.count == 3);
+    CHECK(aggregate.by_app_id.empty() && aggregate.by_output.empty());
+    CHECK(aggregate.by_pid.size() == 1);
+}
+
+static void test_fit_size()
+{
+    auto size = fit_size({100, 50}, {200, 200});
+    CHECK(size.width == 100 && size.height == 50);
+
+    size = fit_size({1920, 1080}, {256, 256});
+    CHECK(size.width == 256 && size.height == 144);
+
+    size = fit_size({1080, 1920}, {256, 256});
+    CHECK(size.width == 144 && size.height == 256);
+
+    /* Never thinner than one pixel */
+    size = fit_size({10000, 1}, {100, 100});
+    CHECK(size.width == 100 && size.height == 1);
+
+    size = fit_size({0, 100}, {100, 100});
+    CHECK(size.width == 0 && size.height == 0);
+    size = fit_size({100, 100}, {0, 100});
+    CHECK(size.width == 0 && size.height == 0);
+}
+
+static void test_downscale_box()
+{
+    /* Each 2x2 block of a 4x4 image becomes one pixel, with a row of padding */
+    const int stride = 5 * 4;
+    std::vector<uint8_t> src(stride * 4, 0xee);
+    for (int y = 0; y < 4; y++)
+    {
+        for (int x = 0; x < 4; x++)
+        {
+            uint8_t *p = &src[y * stride + x * 4];
+            p[0] = (x < 2) ? 10 * (x + y) : 255;
+            p[1] = y * 40;
+            p[2] = x * 80;
+            p[3] = 255;
+        }
+    }
+
+    uint8_t dst[2 * 2 * 4];
+    downscale_box(src.data(), 4, 4, stride, dst, 2, 2, 2 * 4);
+    CHECK(dst[0] == 10 && dst[1] == 20 && dst[2] == 40 && dst[3] == 255);
+    CHECK(dst[4] == 255 && dst[5] == 20 && dst[6] == 200 && dst[7] == 255);
+    CHECK(dst[8] == 30 && dst[9] == 100 && dst[10] == 40 && dst[11] == 255);
+    CHECK(dst[12] == 255 && dst[13] == 100 && dst[14] == 200 && dst[15] == 255);
+
+    /* Uneven ratios and widths which do not fill an SSE2 vector */
+    std::vector<uint8_t> flat(7 * 3 * 4, 0);
+    for (size_t i = 0; i < flat.size(); i += 4)
+    {
+        flat[i] = 1;
+        flat[i + 1] = 128;
+        flat[i + 2] = 254;
+        flat[i + 3] = 255;
+    }
+
+    uint8_t out[3 * 2 * 4];
+    downscale_box(flat.data(), 7, 3, 7 * 4, out, 3, 2, 3 * 4);
+    for (size_t i = 0; i < sizeof(out); i += 4)
+    {
+        CHECK(out[i] == 1 && out[i + 1] == 128 && out[i + 2] == 254 && out[i + 3] == 255);
+    }
+
+    /* Rounded to nearest */
+    const uint8_t row[] = {0, 0, 0, 0, 1, 1, 2, 2, 1, 2, 2, 3};
+    uint8_t pixel[4];
+    downscale_box(row, 3, 1, sizeof(row), pixel, 1, 1, 4);
+    CHECK(pixel[0] == 1 && pixel[1] == 1 && pixel[2] == 1 && pixel[3] == 2);
+}
+
+static void test_process_record()
+{
+    process_record_t record;
+    record.pid   = 42;
+    record.ppid  = 1;
+    record.valid = true;
+    record.executable = "/usr/bin/foo";
+    record.cmdline    = std::string(PROCESS_RECORD_STRING_MAX + 10, 'a');
+    record.cgroup     = "/user.slice";
+    record.rss_kb     = 123456789012ull;
+    record.cpu_time_ms = 7;
+
+    std::string message;
+    encode_process_record(message, record);
+    CHECK(message.size() <= PROCESS_RECORD_MAX);
+
+    process_record_t decoded;
+    CHECK(decode_process_record(message, decoded));
+    CHECK(decoded.pid == 42 && decoded.ppid == 1 && decoded.valid);
+    CHECK(decoded.executable == record.executable);
+    CHECK(decoded.cmdline == record.cmdline.substr(0, PROCESS_RECORD_STRING_MAX));
+    CHECK(decoded.cgroup == record.cgroup);
+    CHECK(decoded.rss_kb == record.rss_kb && decoded.cpu_time_ms == 7);
+
+    /* Truncated and oversized messages are rejected */
+    CHECK(!decode_process_record(std::string_view(message).substr(0, message.size() - 1), decoded));
+    CHECK(!decode_process_record(message + "x", decoded));
+    CHECK(!decode_process_record(std::string_view(message).substr(0, 8), decoded));
+
+    encode_process_record(message, process_record_t{});
+    CHECK(decode_process_record(message, decoded));
+    CHECK(!decoded.valid && decoded.executable.empty() && decoded.cgroup.empty());
+}
+
+int main()
+{
+    test_view_json();
+    test_view_wire();
+    test_workspace();
+    test_filter();
+    test_timeline_ring();
+    test_aggregate();
+    test_fit_size();
+    test_downscale_box();
+    test_process_record();
+
+    if (failures)
+    {
+        fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+
+    return 0;
+}